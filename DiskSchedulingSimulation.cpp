@@ -2,8 +2,68 @@
  * File: program5.cpp
  * Author: Logan Wheat
  * Modification History: 11/17/19 : wrote the code: Logan Wheat
+ *                       10/17/26 : multi-threaded experiment engine
+ *                                  (--threads, --seed, --scaling)
+ *                       10/17/26 : indexed nearest neighbour sstf
+ *                                  (--bench-sstf)
+ *                       10/17/26 : counting sort for requests (--sort,
+ *                                  --bench-sort)
+ *                       10/17/26 : hash set duplicate check and Floyd
+ *                                  sampling generator (--generator)
+ *                       10/17/26 : Philox counter based random streams with
+ *                                  bulk fill
+ *                       10/17/26 : shared seek cost kernel with AVX2/AVX-512
+ *                                  paths (--bench-kernel)
+ *                       10/17/26 : structure of arrays requestQueue used by
+ *                                  the schedulers
+ *                       10/17/26 : streaming trace replay mode (--trace,
+ *                                  --check-trace)
+ *                       10/17/26 : event driven simulation with arrival
+ *                                  processes (--simulate)
+ *                       10/17/26 : latency histograms and percentiles in
+ *                                  every mode
+ *                       10/17/26 : scheduler registry with scan/look
+ *                                  variants, N-step, FSCAN and SATF
+ *                                  (--schedulers)
+ *                       10/17/26 : analytic mode with control variate Monte
+ *                                  Carlo (--analytic, --samples)
+ *                       10/17/26 : adaptive sweep stopping at a confidence
+ *                                  interval target (--ci-target)
+ *                       10/17/26 : disk models with zoned recording and seek
+ *                                  curves (--disk)
+ *                       10/17/26 : benchmark suite and phase profiling with
+ *                                  JSON reports (--bench, --profile, --perf,
+ *                                  --json)
+ *                       10/17/26 : raid 0/1/5/10 array simulation with a
+ *                                  thread per spindle (--raid)
+ *                       10/17/26 : streaming results sinks with a columnar
+ *                                  format, raw dumps and any size range
+ *                                  (--results, --raw, --sizes)
+ *                       10/17/26 : checkpoint and resume of the fixed sweep
+ *                                  (--checkpoint, --checkpoint-seconds,
+ *                                  --resume)
+ *                       10/17/26 : per worker arenas of scratch buffers,
+ *                                  sorters give an index permutation
+ *                       10/17/26 : schedulers only read their queue, order
+ *                                  independence check (--check-order)
+ *                       10/17/26 : schedulers keep their scratch in the
+ *                                  worker's arena
+ *                       10/17/26 : sweeps shared by several processes through
+ *                                  a mapped region, live --status (--shared,
+ *                                  --status)
+ *                       10/17/26 : workload generator with Zipf tracks, hot
+ *                                  zones, sequential runs and duplicate
+ *                                  policies (--generator workload, --zipf,
+ *                                  --zone, --sequential, --duplicates)
+ *                       10/17/26 : sweeps without service time recording
+ *                                  (--no-percentiles)
+ *                       10/17/26 : interleaved sstf and scan/cscan lookups on
+ *                                  one core (--interleave, --bench-interleave)
  * struct:
  *point - stores data such as track, sector, and whether it has been accessed or not
+ *requestQueue - structure of arrays queue of 16 bit tracks and sectors with
+ *an accessed bitmap, read by every scheduler (resizeQueue, isServiced,
+ *markServiced; loadQueue and storeQueue convert from/to points)
  *
  * Procedures:
  *main - driver function of program. Generates random input streams with no duplicates
@@ -12,12 +72,14 @@
  *calculated over the 1000 experiments for sizes 500-1000 to both standard out
  *and a .csv file to properly generate line graph for report.
  *
- *uniform - uniform random number generator that returns an int between perameters.
+ *uniform - uniform random number generator that returns an int between perameters,
+ *drawn from an rngStream. fillUniform makes many at once.
  *
  *swap - function to aid bubble sort by swapping points passed by reference.
  *
- *sortRequest - sorts passed request of points utilizing bubble sort (was
- *having issues with qsort).
+ *sortRequest - sorts passed request of points by track with a stable counting
+ *sort. bubbleSortRequest (the original bubble sort) and stableSortRequest
+ *can be chosen instead with --sort (see findSorter).
  *
  *outputRequest - function to output array of points, used mostly for
  *debugging. Not called during main, but kept for useful tool.
@@ -25,21 +87,250 @@
  *checkSector - function called to ensure sector value stays in range 0-12000,
  *essentially simulates the disk completing a rotation.
  *
+ *stepCost - cost model shared by every scheduler (seek with snapback and
+ *rotational latency of one step). serviceStep applies it to a moving head,
+ *stepCosts works out every step of a known path at once (stepCostsScalar,
+ *stepCostsAvx2, stepCostsAvx512) and pathTime adds them up.
+ *
  *fifo - simulates a first in first out disk scheduling algorithm.
  *
  *sstf - simulates a shortest service time first disk scheduling algorithm.
+ *Keeps unaccessed points in a linked list over the sorted request so the
+ *closest track is found in amortized O(1). sstfLinear is the original linear
+ *search version, kept as a reference. linkQueue builds the list and
+ *nearestTrack takes the closest point; satf and sstfLane share them.
  *
- *scan - simulates a scan disk scheduling algorithm.
+ *scan - simulates a scan disk scheduling algorithm, running on to the last
+ *track before turning (addEdgeStop marks the trip in the path).
  *
  *cscan - simulates a circular scan disk scheduling algorithm.
+ *
+ *look, clook - scan and cscan turning at the last request instead of the
+ *end of the disk (these were scan and cscan before the registry).
+ *
+ *nstep - N-step scan, scan sweeps over batches of --nstep requests in
+ *arrival order.
+ *
+ *satf - shortest access time first (seek plus rotational latency), searching
+ *outwards from the head and stopping once the seek alone rules a track out.
+ *
+ *SCHEDULERS - registry of every scheduler by name (findScheduler,
+ *parseSchedulers); --schedulers picks which run and the output columns
+ *follow it. fscan is scan in a batch and its own policy in --simulate.
+ *
+ *replayTrace - replays a blkparse, MSR-Cambridge CSV or binary block I/O
+ *trace through the schedulers in fixed size windows (--trace). Traces are
+ *streamed through a fixed buffer by traceReader (openTrace, nextTraceRecord,
+ *closeTrace) and mapped onto the disk by tracePoint. checkTrace checks the
+ *text parsers against fixture lines (--check-trace).
+ *
+ *runOnline - event driven simulation with requests arriving over time
+ *(--simulate). simulateOnline runs an eventQueue (pooled binary heap of
+ *simEvents) with poisson, onoff or trace arrivals (nextArrival); each time
+ *the disk is free the scheduler picks from the pendingSet (takePending).
+ *
+ *rngStream - per experiment Philox4x32-10 counter based random stream
+ *(philoxBlocks, seedStream, advanceStream, nextRandom, fillRandom) used in
+ *place of rand(). Each experiment is seeded by index, so it can be rerun on
+ *its own.
+ *
+ *generateRequest - fills a request with unique uniform random points,
+ *redrawing duplicates found with an addressSet hash set (clearAddresses,
+ *insertAddress). sampleRequest samples without replacement instead (Floyd's
+ *algorithm plus a shuffle); chosen with --generator (see findGenerator).
+ *
+ *runSweep - runs the experiments on a pool of worker threads (sweepWorker,
+ *runTile) and merges per tile accumulators in a fixed order so results are
+ *bit-reproducible for any thread count.
+ *
+ *scalingReport - reruns the sweep at increasing thread counts and prints
+ *speedup and efficiency.
+ *
+ *parseOptions - reads the command line options.
+ *
+ *benchSstf - times sstf against sstfLinear for queue sizes up to 10^6.
+ *
+ *benchSort - times each sorting stage against bubble sort at 500, 10^4 and
+ *10^6 requests.
+ *
+ *benchKernel - times each stepCosts version and checks it matches
+ *serviceStep bit for bit.
+ *
+ *benchInterleave - times sstf, scan and cscan back to back against
+ *interleaveLanes at each --interleave width.
+ *
+ *schedulerLane - one experiment's scheduler run as a state machine
+ *(sstfLane, searchLane, scanLane, cscanLane). startLane sets a lane up and
+ *interleaveLanes steps several in turn so their cache misses overlap;
+ *scanFrom and cscanFrom finish scan and cscan from a known start point.
+ *
+ *latencyHistogram - log-linear histogram of service and response times
+ *(clearHistogram, recordLatency, recordPath, mergeHistogram,
+ *latencyPercentile). Every scheduler records into one when given it; the
+ *sweep keeps one per size and algorithm and outputPercentiles prints p50,
+ *p90, p99, p99.9 and max.
+ *
+ *runAnalytic - analytic mode (--analytic). buildAnalyticModel works the mean
+ *rotational latency of every track distance and the mean fifo step out of
+ *the cost model (expectedRotation), so fifo is exact; the other schedulers
+ *run --samples experiments per size and are corrected with control variates
+ *(controlPaths, whose means controlMean gives in closed form, fitted by
+ *controlEstimate), printing 95% confidence intervals.
+ *
+ *runAdaptive - adaptive sweep (--ci-target, --min-experiments). Keeps a
+ *running mean and variance of every (size, scheduler) cell (runningStat:
+ *addSample, mergeStat, statHalfWidth) and stops sampling a cell once its 95%
+ *confidence interval is narrow enough, giving the runs it saves to the noisy
+ *cells. The .csv has the interval and sample count of every cell in every
+ *sweep.
+ *
+ *classicDisk, diskModel, loadDiskModel - compile time classic disk and disk
+ *files with zones and a seek curve; stepCostModel, satfModel - cost kernels
+ *for either model; addressPoint, randomPoint - place requests on the active
+ *disk
+ *
+ *benchSuite - times generation, sorting, loading and every scheduler at 10^2
+ *to 10^6 requests (benchCase), optionally against an earlier JSON report
+ *(readBenchBaseline, writeBenchJson).
+ *
+ *phaseProfile - per phase time of a sweep (--profile) filled in by
+ *scopedTimer, with hardware counters from perf_event_open when --perf is
+ *given (openPerfCounters, readPerfCounters); outputProfile and
+ *writeProfileJson report it.
+ *
+ *runArray - raid array version of --simulate (--raid, --disks,
+ *--stripe-unit, --request-sectors, --write-fraction). simulateArray draws
+ *logical requests, splits them over the spindles (splitRequest) and hands
+ *the members to one spindleWorker thread per spindle through lock free
+ *single producer single consumer rings (handoffRing: pushRing, popRing); a
+ *request completes with its slowest member.
+ *
+ *resultsSink - buffered csv or columnar (.dscol) results file
+ *
+ *openSink/sinkRows/closeSink - open, append rows to and finish a results
+ *file
+ *
+ *sinkWritable - whether a results file can be created, before a run
+ *
+ *readResults - print a columnar results file as csv
+ *
+ *checkpointKey - options a checkpoint must match to be resumed
+ *
+ *writeCheckpoint/readCheckpoint - save and load the sweep accumulators,
+ *atomically replacing the old save
+ *
+ *workerArena/reserveArena - per worker buffers grown once to the largest
+ *request, including the pathScratch the schedulers work in
+ *
+ *reserveLanes - extra arena queues and scratch for --interleave
+ *
+ *loadSortedQueue - loads a queue through a sorter's permutation
+ *
+ *checkOrder - runs every scheduler forwards, backwards and concurrently on
+ *the same queues and compares
+ *
+ *openShared, mapShared, closeShared - create, join or map the region of a
+ *shared sweep; layoutShared lays it out after its header
+ *
+ *claimTile, finishTile - hand out the tiles of a shared sweep through its
+ *atomic counter, take over the tiles of processes that died, and mark them
+ *done
+ *
+ *mergeShared, loadShared - add a tile's histogram into a shared one without
+ *a lock, and read it back
+ *
+ *runShared - runs this process's part of a shared sweep; the process
+ *completing the last tile merges the results in block order
+ *
+ *sharedStatus - throughput, ETA, processes and partial results of a shared
+ *sweep, read without disturbing it
+ *
+ *buildWorkload - folds the zones and Zipf exponent of a workload into one
+ *share per track and builds its alias table
+ *
+ *workloadRequest - fills a request from activeWorkload with its random
+ *numbers drawn in bulk, applying the duplicate policy; workloadAddress draws
+ *one address
+ *
+ *generatorName - describes the generator of a sweep, with the workload
+ *settings, for checkpoints and shared sweeps
  ***********************************************************************/
 #include <iostream>
-#include <cstdlib> // for use of rand()
+#include <cstdlib> // for atoi() and strtoull()
 #include <cmath> // for use of abs()
 #include <fstream> // to output to .csv file
+#include <thread> // for the worker threads that run experiments
+#include <atomic> // for handing out tiles to worker threads
+#include <mutex> // for serializing progress output between workers
+#include <vector> // for per tile accumulators
+#include <memory> // for unique_ptr
+#include <chrono> // for timing sweeps in the scaling report
+#include <cstring> // for strcmp() and memcmp()
+#include <cstdint> // for fixed width random stream state
+#include <algorithm> // for min() and max()
+#include <climits> // for INT_MAX
+#include <cstdio> // for streaming trace files
+#include <string> // for phase and benchmark names
+#include <cerrno> // for why the hardware counters could not be opened
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h> // for the vector versions of stepCosts()
+#endif
+#ifdef __linux__
+#include <unistd.h> // for reading and closing the hardware counters, and fsync() of checkpoints
+#include <sys/ioctl.h> // for starting the hardware counters
+#include <sys/syscall.h> // for perf_event_open()
+#include <linux/perf_event.h> // for the hardware counter attributes
+#include <fcntl.h> // for creating the region of a shared sweep
+#include <sys/mman.h> // for mapping the region of a shared sweep
+#include <sys/stat.h> // for waiting until another process has sized the region
+#include <signal.h> // for finding out whether the process running a shared tile is still alive
+#endif
 
 using namespace std;
 
+const int FIRST_SIZE = 500; // smallest request size simulated without --sizes
+const int LAST_SIZE = 1000; // largest request size simulated without --sizes
+const char *const DEFAULT_SCHEDULERS = "fifo,sstf,look,clook"; // schedulers run without --schedulers
+const int NUM_PERCENTILES = 4; // percentiles reported besides the max
+const double PERCENTILES[NUM_PERCENTILES] = { 50, 90, 99, 99.9 };
+const int HISTOGRAM_LOCKS = 64; // stripes of locks guarding the sweep histograms
+const int BLOCK_EXPERIMENTS = 10; // experiments per work tile
+const int MAX_INTERLEAVE = 8; // most experiments --interleave runs side by side
+const int MAX_ZONES = 64; // recording zones a disk model can have
+const int MAX_GEOMETRY = 65536; // most tracks, and sectors on a track, the 16 bit requestQueue can hold
+const size_t TRACE_BUFFER_BYTES = 1 << 20; // bytes of a trace read at a time
+const size_t TRACE_RECORD_BYTES = 24; // size of a binary trace record
+const uint64_t TRACE_LBA_BYTES = 512; // bytes per block in byte offset traces
+const char TRACE_MAGIC[8] = { 'D', 'S', 'T', 'R', 'A', 'C', 'E', '1' }; // start of a binary trace
+enum traceFormat { TRACE_BLKPARSE, TRACE_MSR, TRACE_BINARY };
+const int HISTOGRAM_BUCKETS = 1728; // log-linear buckets covering values below 2^32
+const int NUM_CONTROLS = 4; // control paths of the analytic mode, see controlPaths
+const double CONFIDENCE_Z = 1.96; // normal quantile of a 95% confidence interval
+const int NUM_PERF_COUNTERS = 4; // hardware counters of --perf, see PERF_COUNTER_NAMES
+const char *const PERF_COUNTER_NAMES[NUM_PERF_COUNTERS] = { "cycles", "instructions", "cache_misses", "branch_misses" };
+const int BENCH_REPETITIONS = 5; // timed repetitions of every --bench case
+const int HANDOFF_SLOTS = 4096; // member requests a spindle's rings hold, a power of two
+const size_t SINK_BUFFER_BYTES = 1 << 16; // text a csv results file buffers before writing
+const size_t SINK_GROUP_ROWS = 4096; // rows in each row group of a columnar results file
+const char COLUMNAR_MAGIC[8] = { 'D', 'S', 'C', 'O', 'L', '1', '\r', '\n' }; // start and end of a columnar results file
+const char CHECKPOINT_MAGIC[8] = { 'D', 'S', 'C', 'K', 'P', 'T', '1', '\n' }; // start of a sweep checkpoint
+const int EPOCH_TILES_PER_THREAD = 8; // tiles per worker in each epoch of a checkpointed sweep
+const int CHECK_EXPERIMENTS = 10; // experiments per size of --check-order
+const int REJECT_TRIES = 64; // draws of a workload request before a duplicate is shifted instead
+const char SHARED_MAGIC[8] = { 'D', 'S', 'S', 'H', 'R', 'D', '1', '\n' }; // start of the region of a shared sweep
+const int SHARED_KEY_BYTES = 1024; // longest checkpointKey a shared sweep can hold
+const int SHARED_WAIT_MS = 10000; // longest a process waits for another to set up the region of a shared sweep
+const double BENCH_REGRESSION = 1.1; // --bench cases slower than the baseline by this ratio are flagged
+enum onlinePolicy { ONLINE_FIFO, ONLINE_SSTF, ONLINE_SCAN, ONLINE_CSCAN, ONLINE_LOOK, ONLINE_CLOOK, ONLINE_FSCAN, ONLINE_NSTEP,
+		   ONLINE_SATF };
+enum eventType { EVENT_ARRIVAL, EVENT_COMPLETION };
+enum arrivalProcess { ARRIVAL_POISSON, ARRIVAL_ONOFF, ARRIVAL_TRACE };
+enum duplicatePolicy { DUPLICATES_REJECT, DUPLICATES_ALLOW, DUPLICATES_SHIFT }; // see workloadModel
+const char *const DUPLICATE_NAMES[] = { "reject", "allow", "shift" }; // --duplicates names of each duplicatePolicy
+enum tilePhase { TILE_WAITING, TILE_RUNNING, TILE_MERGING, TILE_DONE }; // progress of a tile of a shared sweep
+enum sweepPhase { PHASE_GENERATE, PHASE_SORT, PHASE_LOAD, PHASE_SCHEDULER }; // PHASE_SCHEDULER + i is scheduler i
+enum laneStage { LANE_START, LANE_LOOKUP, LANE_FINISH, LANE_DONE }; // stages of a schedulerLane
+
 /***************************************************************************
  * struct point
  * Author: Logan Wheat
@@ -57,563 +348,9075 @@ struct point
 };
 
 /***************************************************************************
- * int uniform(int, int)
- * Author: Richard Goodrum
- * Date: 3 November 2019
- * Description: uniform random number generator
- *
- * Parameters:
- * lo I/P int the lower bound of random number range
- * hi I/P int the upper bound of random number range
+ * struct classicDisk
+ * Date: 17 October 2026
+ * Description: the disk the simulation was written for as a compile time
+ *disk model: 5000 tracks with 12000 sectors each, the head starting on
+ *track 2499, 800 nanoseconds per track crossed, 500 nanoseconds per sector
+ *and a 1.5 millisecond snapback. Everything is static and constexpr, so
+ *stepCostModel<classicDisk> folds down to the original arithmetic, and the
+ *vector versions of stepCosts are written for it. Another drive known at
+ *compile time can be added the same way; anything else is a diskModel
+ *read at run time.
+ **************************************************************************/
+struct classicDisk
+{
+  static constexpr int tracks = 5000; // tracks 0-4999
+  static constexpr int startTrack = 2499; // track the head starts on
+  static constexpr int sectors = 12000; // sectors 0-11999 on every track
+  static constexpr double trackMs = .0008; // seek time per track crossed
+  static constexpr double sectorMs = .0005; // time for one sector to pass under the head
+  static constexpr double snapbackMs = 1.5; // snapback to track 0
+
+  static double seekTime(double distance) { return (distance * trackMs); }
+  static double sectorsOn(double /*track*/) { return sectors; }
+  static double sectorTime(double /*track*/) { return sectorMs; }
+  static double sectorOn(double sector, double /*fromTrack*/, double /*toTrack*/) { return sector; }
+};
+
+/***************************************************************************
+ * struct diskModel
+ * Date: 17 October 2026
+ * Description: geometry and timing of the simulated disk, read at run time
+ *by loadDiskModel (--disk). Tracks are split into zones of equal sectors
+ *per track (zoned recording) and the seek curve is
+ *settleMs + accelMs * sqrt(distance) up to accelTracks, then linear at
+ *trackMs per track, so it can express a head that accelerates and settles
+ *as well as the original linear seek. The snapback is snapbackMs plus the
+ *seek out from track 0. A rotation takes rotationMs on every track, so
+ *tracks with fewer sectors pass each one more slowly. Member functions
+ *match classicDisk so the same stepCostModel works on both.
  **************************************************************************/
-int uniform(int lo, int hi)
+struct diskModel
 {
-  int x;
-  int y = hi - lo + 1;
-  int z = RAND_MAX / y;
+  bool compiled; // this is classicDisk, run with the compile time kernels
+  int tracks; // number of tracks
+  int startTrack; // track the head starts on
+  double rotationMs; // time of one rotation
+  double trackMs; // seek time per track crossed past accelTracks
+  double settleMs; // settle time of every seek that moves the head
+  double accelMs; // seek time per square root of the tracks crossed, up to accelTracks
+  int accelTracks; // distance the head is still accelerating over
+  double snapbackMs; // time to snap back to track 0
+  int zones; // number of recording zones
+  int zoneFirst[MAX_ZONES]; // first track of each zone, ascending from 0
+  int zoneSectors[MAX_ZONES]; // sectors on each track of the zone
+  uint64_t zoneAddress[MAX_ZONES + 1]; // address of the first sector of each zone, and the total
+  int64_t addresses; // sectors on the whole disk
+  vector<int> sectorCount; // sectors on each track
+  vector<double> sectorMs; // time for one sector of each track to pass under the head
 
-  while (y <= (x = (rand() / z)));
+  double seekTime(double distance) const
+  {
+    if (distance == 0)
+      return 0;
+    if (distance <= accelTracks)
+      return (settleMs + accelMs * sqrt(distance));
+    return (settleMs + accelMs * sqrt((double)accelTracks) + trackMs * (distance - accelTracks));
+  }
+  double sectorsOn(double track) const { return sectorCount[(int)track]; }
+  double sectorTime(double track) const { return sectorMs[(int)track]; }
+  double sectorOn(double sector, double fromTrack, double toTrack) const
+  {
+    // the same angle measured in the sectors of another track
+    if (zones == 1)
+      return sector;
+    return (sector * sectorCount[(int)toTrack] / sectorCount[(int)fromTrack]);
+  }
+};
 
-  return x + lo;
-}
+// disk being simulated, set by parseOptions before anything runs and only read after that
+diskModel activeDisk;
 
 /***************************************************************************
- * void swap(point *, point*)
- * Author: Logan Wheat
- * Date: 17 November 2019
- * Description: swaps the perameters, utilized in bubble sort algorithm
-*
-* Parameters:
-* x I/P point*  the first point passed to be swapped with the second
-* y I/P point*  the second point passed to be swapped with the first
-**************************************************************************/
-void swap(point *x, point *y)
+ * struct workloadZone
+ * Date: 17 October 2026
+ * Description: range of tracks a share of a workload's requests go to
+ *(--zone), e.g. a file system's metadata near the start of the disk.
+ **************************************************************************/
+struct workloadZone
 {
-  point temp = *x;
-  *x = *y;
-  *y = temp;
-}
+  int firstTrack; // first track of the zone
+  int lastTrack; // last track of the zone
+  double weight; // share of the requests, relative to the other zones
+};
 
 /***************************************************************************
- * void sortRequest(point[], int)
- * Author: Logan Wheat
- * Date: 17 November 2019
- * Description: sorts the array of points utilizing a bubble sort algorithm
- *
- * Parameters:
- * request I/P point[]  array of points to be sorted (sorted by track in ascending order)
- * size I/P int  size of array that is to be sorted
+ * struct workloadModel
+ * Date: 17 October 2026
+ * Description: skewed workload the workload generator draws requests from
+ *instead of uniform addresses. A fresh request's track comes from a
+ *mixture of zones (the whole disk if none are given), spread over the
+ *zone's tracks uniformly by sector or, with a Zipf exponent, by Zipf's law
+ *on the track's rank in the zone (its first track the hottest). The
+ *mixture is folded into one share per track and sampled with an alias
+ *table, so any workload costs one lookup per draw. The sector is uniform
+ *on the track. A request may instead continue the sequential run of the
+ *one before it (the next address). Like activeDisk, activeWorkload is set
+ *up once by buildWorkload before any thread reads it.
  **************************************************************************/
-void sortRequest(point request[], int size)
+struct workloadModel
 {
-  int i, j;
-  for (i = 0; i < size - 1; i++)
-    {
-      // Last i elements are already in place  
-      for (j = 0; j < size - i - 1; j++)
-	{
-	  if (request[j].track > request[j + 1].track)
-	    swap(&request[j], &request[j + 1]);
-	}
-    }
-}
+  double zipf; // Zipf exponent of a track's rank in its zone, 0 to spread the zone uniformly by sector
+  vector<workloadZone> zones; // zones of the mixture, empty for the whole disk
+  double sequential; // chance a request continues the run of the one before it
+  int duplicates; // what is done with a request already in the queue, see duplicatePolicy
+  vector<uint32_t> threshold; // alias table: column t gives track t if the coin is below threshold[t]
+  vector<uint32_t> alias; // and track alias[t] if not
+  vector<uint32_t> trackAddress; // address of sector 0 of every track
+  uint32_t sequentialCoin; // a request continues the run if its coin is below this
+};
+
+workloadModel activeWorkload;
 
 /***************************************************************************
- * void outputRequest(point[], int)
- * Author: Logan Wheat
- * Date: 15 November 2019
- * Description: outputs all the track and sector pairs of a point array size(requestSize)
- *
- * Parameters:
- * request I/P point[]  array of points to be sent to standard output
- * requestSize I/P int  The size of the array to be output
+ * struct requestQueue
+ * Date: 17 October 2026
+ * Description: queue of points the schedulers work on, stored as a
+ *structure of arrays. Tracks (0-4999) and sectors (0-11999) both fit in 16
+ *bits and whether a point has been accessed is one bit, so a point takes 4
+ *bytes and a bit instead of the 24 bytes of a point struct. Scans over the
+ *queue only touch the array they need. loadQueue and storeQueue convert
+ *to and from point arrays.
  **************************************************************************/
-void outputRequest(point request[], int requestSize)
+struct requestQueue
 {
-  cout << "Track\tSector" << endl;
-  for (int i = 0; i < requestSize; i++)
-    {
-      cout << i << ": " << request[i].track << "\t" << request[i].sector << endl;
-    }
-}
+  vector<uint16_t> track; // track of each point
+  vector<uint16_t> sector; // sector of each point
+  vector<uint64_t> serviced; // bit i is set once point i has been accessed
+  int size; // number of points in the queue
+};
 
 /***************************************************************************
- * double checkSector(double)
- * Author: Logan Wheat
- * Date: 16 November 2019
- * Description: simulates disk completing a rotation by ensuring sector 
- *stays in the range of 0-12000.
+ * struct pathScratch
+ * Date: 17 October 2026
+ * Description: scratch arrays of the schedulers: the path the head is sent
+ *along with the step costs pathTime() works out for it, the linked list
+ *of sstf and satf, and the batch order of nstep. Every worker keeps one in
+ *its workerArena and hands it to each scheduler it runs; reserveArena
+ *grows it once (see reservePath), so the schedulers do not allocate.
+ **************************************************************************/
+struct pathScratch
+{
+  vector<double> track; // track of every stop
+  vector<double> sector; // sector of every stop
+  vector<uint8_t> edge; // 1 for the stops at the edge of the disk
+  vector<double> seek; // seek time of every stop, or of every step of sstf and satf
+  vector<double> rotation; // rotational latency of every stop
+  vector<int> prev; // previous unaccessed index of sstf and satf, -1 if none
+  vector<int> next; // next unaccessed index of sstf and satf, the queue size if none
+  vector<int> order; // indexes of one batch of nstep, sorted by track
+};
+
+/***************************************************************************
+ * void reservePath(pathScratch &, int)
+ * Date: 17 October 2026
+ * Description: grows a pathScratch to hold the scratch of a queue of
+ *requests points. A path has at most two stops per request plus two,
+ *since nstep can turn at the edge of the disk after every batch.
  *
  * Parameters:
- * sector I/O double  sector passed to ensure stays within range, returned to function
+ * scratch I/O pathScratch&  scratch to be grown
+ * requests I/P int  largest queue it will be used for
  **************************************************************************/
-double checkSector(double sector)
+void reservePath(pathScratch &scratch, int requests)
 {
-  if (sector < 12000)
-    {
-      return (sector + 12000);
-    }
-  else if (sector > 12000)
-    {
-      return (sector - 12000);
-    }
-  return sector;
+  size_t stops = 2 * (size_t)requests + 2;
+
+  if (scratch.track.size() >= stops)
+    return;
+  scratch.track.resize(stops);
+  scratch.sector.resize(stops);
+  scratch.edge.resize(stops);
+  scratch.seek.resize(stops);
+  scratch.rotation.resize(stops);
+  scratch.prev.resize(requests);
+  scratch.next.resize(requests);
+  scratch.order.resize(requests);
 }
 
 /***************************************************************************
- * double fifo(point[], int)
- * Author: Logan Wheat
- * Date: 15 November 2019
- * Description: simulates a first in first out disk scheduling algorithm.
- *Calculates the total time spent seeking and then returns
- *(total time / request size) to calculate average seek time between
- *requests in milliseconds.
- *
- * Parameters:
- * request I/P point[]  array of points that will be accessed in fifo algorithm
- * requestSize I/P int  size of array of points, that way function does not exceed bounds
-**************************************************************************/
-double fifo(point request[], int requestSize)
+ * struct schedulePath
+ * Date: 17 October 2026
+ * Description: path a scheduler sends the head along, with the edge stops
+ *flagged (see addStop, addEdgeStop), and the scratch pathTime() works out
+ *its step costs in, all in the front of a worker's pathScratch.
+ **************************************************************************/
+struct schedulePath
 {
-  double totalTime = 0; // initialize total time to zero in milliseconds
+  double *track; // track of every stop
+  double *sector; // sector of every stop
+  uint8_t *edge; // 1 for the stops at the edge of the disk
+  double *seek; // seek time of every stop, worked out by pathTime
+  double *rotation; // rotational latency of every stop, worked out by pathTime
+  int stops; // stops in the path
 
-  double currentTrack = 2499; // start in the middle of the track
-  double currentSector = 0; // start at sector 0
-  double trackDistance; // declare track distance as a double
+  schedulePath(int requests, pathScratch &scratch) : stops(0)
+  {
+    reservePath(scratch, requests);
+    track = scratch.track.data();
+    sector = scratch.sector.data();
+    edge = scratch.edge.data();
+    seek = scratch.seek.data();
+    rotation = scratch.rotation.data();
+  }
+};
 
-  // for loop to iterate through all request and simulate fifo
-  for (int i = 0; i < requestSize; i++)
-    {
-      // track distance will be used to determine new current sector
-      trackDistance = abs(currentTrack - request[i].track);
-      currentTrack = request[i].track; // set current track as the requested track
+/***************************************************************************
+ * struct traceRecord
+ * Date: 17 October 2026
+ * Description: one request read from a block I/O trace.
+ **************************************************************************/
+struct traceRecord
+{
+  double time; // arrival time in seconds
+  uint64_t lba; // first block accessed
+  uint32_t length; // number of blocks
+  bool write; // true for a write, false for a read
+};
+
+/***************************************************************************
+ * struct traceReader
+ * Date: 17 October 2026
+ * Description: streams records out of a trace file through a fixed size
+ *buffer, so traces of any size are read in constant memory.
+ **************************************************************************/
+struct traceReader
+{
+  FILE *file; // trace being read
+  int format; // TRACE_BLKPARSE, TRACE_MSR or TRACE_BINARY
+  vector<char> buffer; // chunk of the file being parsed
+  size_t begin; // first unread byte of buffer
+  size_t end; // end of the valid bytes in buffer
+  bool eof; // the whole file has been read into the buffer
+  uint64_t records; // records returned so far
+  uint64_t skipped; // lines that were not requests
+  double firstTime; // time of the first record
+};
+
+/***************************************************************************
+ * struct latencyHistogram
+ * Date: 17 October 2026
+ * Description: log-linear histogram of latencies (in the style of
+ *HdrHistogram). Values are kept in microseconds; below 128 every value has
+ *its own bucket, above that every power of two is split into 64 buckets,
+ *so any value is off by less than 1.6% and recording is a couple of shifts.
+ *Values of 2^32 microseconds (71 minutes) and over share the last bucket.
+ **************************************************************************/
+struct latencyHistogram
+{
+  uint64_t counts[HISTOGRAM_BUCKETS]; // number of values in each bucket
+  uint64_t total; // number of values recorded
+  double sum; // sum of the values in milliseconds
+  double max; // largest value in milliseconds
+};
+
+/***************************************************************************
+ * struct runningStat
+ * Date: 17 October 2026
+ * Description: running mean and variance of the average seek times of one
+ *(size, scheduler) cell, updated one experiment at a time with Welford's
+ *method (addSample) so no samples are kept, and combined with mergeStat.
+ **************************************************************************/
+struct runningStat
+{
+  long count; // number of samples
+  double mean; // mean of the samples
+  double m2; // sum of squared differences from the mean
+};
+
+/***************************************************************************
+ * struct perfCounters
+ * Date: 17 October 2026
+ * Description: hardware counters of the calling thread (--perf), opened as
+ *one perf_event_open group so they are all read with a single read().
+ *Counts are user space only. open is false where the kernel, the CPU or a
+ *virtual machine does not give access to them, and nothing is counted.
+ **************************************************************************/
+struct perfCounters
+{
+  int fd[NUM_PERF_COUNTERS]; // one per counter, fd[0] leads the group
+  bool open; // every counter was opened
+};
+
+/***************************************************************************
+ * struct phaseProfile
+ * Date: 17 October 2026
+ * Description: time spent in each phase of a sweep (--profile): calls,
+ *nanoseconds, requests handled and, with --perf, the hardware counters.
+ *Each worker keeps its own and they are added up with mergeProfile, so
+ *the times are thread time rather than wall time.
+ **************************************************************************/
+struct phaseProfile
+{
+  vector<string> names; // name of each phase
+  vector<uint64_t> calls; // times each phase ran
+  vector<uint64_t> ns; // nanoseconds spent in each phase
+  vector<uint64_t> items; // requests handled by each phase
+  vector<uint64_t> counters; // hardware counts of each phase [phase][counter]
+  perfCounters perf; // counters of the thread filling it in
+};
+
+/***************************************************************************
+ * struct scopedTimer
+ * Date: 17 October 2026
+ * Description: adds the time (and hardware counts) from its construction
+ *to the end of its scope to one phase of a phaseProfile. With a NULL
+ *profile it does nothing, so the sweep can leave the timers in place when
+ *it is not being profiled.
+ **************************************************************************/
+struct scopedTimer
+{
+  phaseProfile *profile; // profile added to, or NULL
+  int phase; // phase the time goes to
+  long items; // requests handled in the scope
+  chrono::steady_clock::time_point start; // time the scope began
+  uint64_t counters[NUM_PERF_COUNTERS]; // hardware counts when the scope began
+
+  scopedTimer(phaseProfile *profile, int phase, long items);
+  ~scopedTimer();
+};
+
+/***************************************************************************
+ * struct benchResult
+ * Date: 17 October 2026
+ * Description: result of one case of the benchmark suite (see benchCase).
+ **************************************************************************/
+struct benchResult
+{
+  string name; // kind/variant/size, for example schedule/sstf/1000
+  long iterations; // iterations in each timed batch
+  double ns; // median nanoseconds per iteration over the batches
+  double minNs; // nanoseconds per iteration of the fastest batch
+  long items; // requests handled by one iteration
+  double counters[NUM_PERF_COUNTERS]; // hardware counts per iteration, 0 without --perf
+};
+
+/***************************************************************************
+ * struct resultsSink
+ * Date: 17 October 2026
+ * Description: results file written a few rows at a time (openSink,
+ *sinkRows, closeSink), from any thread. Comma separated text is formatted
+ *into a buffer that is written out whenever it fills. The columnar format
+ *(.dscol) is laid out like a small Parquet file: COLUMNAR_MAGIC, then row
+ *groups of up to SINK_GROUP_ROWS rows, each stored a column at a time as
+ *little endian 8 byte values (int64 or double), then a footer with the
+ *columns (type byte, name length, name), the row groups (rows, file
+ *offset), the footer's length and COLUMNAR_MAGIC again. A reader can take
+ *one column without reading the others (see readResults).
+ **************************************************************************/
+struct resultsSink
+{
+  FILE *file; // file being written, NULL once closed
+  bool columnar; // columnar format instead of text
+  vector<string> names; // name of each column
+  string types; // type of each column, 'i' (int64) or 'd' (double)
+  vector<char> text; // text not written yet
+  vector<double> group; // rows of the current row group [row][column]
+  vector<uint64_t> groupRows; // rows in each row group written
+  vector<uint64_t> groupOffsets; // file offset of each row group written
+  uint64_t offset; // bytes written so far
+  uint64_t rows; // rows added so far
+  bool failed; // the file could not be created or written
+  mutex lock; // serializes writers
+};
+
+/***************************************************************************
+ * struct simEvent
+ * Date: 17 October 2026
+ * Description: event of the discrete event simulation. Events live in the
+ *pool of an eventQueue and are reused, so none are allocated per event.
+ **************************************************************************/
+struct simEvent
+{
+  double time; // time the event happens in milliseconds
+  uint64_t sequence; // order events were scheduled in, breaks ties in time
+  int type; // EVENT_ARRIVAL or EVENT_COMPLETION
+  int request; // index of the request in the pendingSet pool
+};
+
+/***************************************************************************
+ * struct eventQueue
+ * Date: 17 October 2026
+ * Description: priority queue of events, a binary heap of indexes into a
+ *pool of events with a free list.
+ **************************************************************************/
+struct eventQueue
+{
+  vector<simEvent> pool; // every event ever needed, reused once handled
+  vector<int> freeEvents; // indexes of pool entries not in use
+  vector<int> heap; // min heap of pool indexes ordered by (time, sequence)
+  uint64_t sequence; // sequence number of the next event scheduled
+};
+
+/***************************************************************************
+ * struct simRequest
+ * Date: 17 October 2026
+ * Description: request waiting for (or being serviced by) the disk.
+ **************************************************************************/
+struct simRequest
+{
+  double arrival; // arrival time in milliseconds
+  uint16_t track; // requested track
+  uint16_t sector; // requested sector
+  int next; // next request in the same list, -1 if none
+};
+
+/***************************************************************************
+ * struct pendingSet
+ * Date: 17 October 2026
+ * Description: requests that have arrived but not been serviced. fifo keeps
+ *them in one arrival order list. The other schedulers keep one arrival
+ *order list per track plus a bitmap of tracks that have requests, so the
+ *closest track above or below the head is found by scanning 64 tracks at a
+ *time. fscan and nstep keep new arrivals in the arrival order list and
+ *only move them into the per track lists (a batch at a time) once those
+ *are empty. Requests come from a pool with a free list.
+ **************************************************************************/
+struct pendingSet
+{
+  vector<simRequest> pool; // every request ever needed, reused once serviced
+  vector<int> freeRequests; // indexes of pool entries not in use
+  int policy; // scheduler choosing from the set (ONLINE_FIFO...)
+  int batch; // requests moved into the per track lists at once (nstep), 0 for all
+  int first; // oldest request in the arrival order list, -1 if none
+  int last; // newest request in the arrival order list, -1 if none
+  vector<int> head; // oldest request on each track, -1 if none
+  vector<int> tail; // newest request on each track, -1 if none
+  vector<uint64_t> occupied; // bit t is set if track t has requests
+  int count; // number of requests in the set
+  int active; // number of requests in the per track lists
+  bool up; // scan and look are moving towards higher tracks
+};
+
+/***************************************************************************
+ * struct onlineStats
+ * Date: 17 October 2026
+ * Description: totals of one run of simulateOnline.
+ **************************************************************************/
+struct onlineStats
+{
+  uint64_t requests; // requests serviced
+  uint64_t events; // events handled
+  double busyTime; // time the disk spent servicing requests in milliseconds
+  double queueArea; // integral of the number of pending requests over time
+  double endTime; // time of the last event in milliseconds
+};
+
+/***************************************************************************
+ * struct memberRequest
+ * Date: 17 October 2026
+ * Description: part of a logical request that one spindle of an array
+ *services: a run of sectors starting at a disk address. Handed to the
+ *spindle at its arrival time and handed back with its completion time.
+ **************************************************************************/
+struct memberRequest
+{
+  double time; // arrival time going to the spindle, completion time coming back
+  uint64_t logical; // number of the logical request it is part of
+  int64_t address; // first sector on the spindle (see addressPoint)
+  int length; // sectors transferred
+  bool rewrite; // read and then written back a rotation later (raid 5 read-modify-write)
+};
+
+/***************************************************************************
+ * struct handoffRing
+ * Date: 17 October 2026
+ * Description: single producer, single consumer ring of member requests
+ *between the array coordinator and one spindle worker, with no locks. The
+ *producer only writes tail and the consumer only writes head, each on its
+ *own cache line; a release store of the index publishes the slot and an
+ *acquire load on the other side sees it. closed is set by the producer
+ *once nothing more will be pushed.
+ **************************************************************************/
+struct handoffRing
+{
+  memberRequest slots[HANDOFF_SLOTS]; // requests, slot i % HANDOFF_SLOTS
+  alignas(64) atomic<uint64_t> head; // next slot to be popped
+  alignas(64) atomic<uint64_t> tail; // next slot to be pushed
+  atomic<bool> closed; // the producer is done
+};
+
+/***************************************************************************
+ * struct arrayRequest
+ * Date: 17 October 2026
+ * Description: logical request of an array waiting for its members.
+ **************************************************************************/
+struct arrayRequest
+{
+  double arrival; // arrival time in milliseconds
+  double finish; // completion time of the slowest member so far
+  int remaining; // members not yet complete
+  int slowest; // spindle of the slowest member so far
+};
+
+/***************************************************************************
+ * struct schedulerLane
+ * Date: 17 October 2026
+ * Description: one experiment's scheduler run as a state machine, so the
+ *runs of several experiments can take turns on one core (see
+ *interleaveLanes). Each step of a lane goes as far as its next lookup in
+ *the queue, prefetches what that lookup reads and returns, and the other
+ *lanes run while the cache line comes in. The lookups are sstf's nearest
+ *track search and the start point search of scan and cscan.
+ **************************************************************************/
+struct schedulerLane
+{
+  const requestQueue *request; // queue the scheduler runs on
+  latencyHistogram *histogram; // records the service time of every request, if not NULL
+  pathScratch *scratch; // scratch of this lane's run
+  laneStage stage; // where the lane stopped
+  int low; // start of the range the start point search has left, the start point once found
+  int high; // end of that range
+  double currentTrack; // track the head is on (sstf)
+  double currentSector; // sector the head is on (sstf)
+  double totalTime; // time of the requests serviced so far (sstf)
+  int left; // closest unaccessed index below the head (sstf)
+  int right; // closest unaccessed index at or above the head (sstf)
+  int serviced; // requests serviced so far (sstf)
+  int pending; // requests to be serviced (sstf)
+  double average; // average seek time in milliseconds, once the lane is done
+};
+
+// runs a schedulerLane up to its next lookup, false once its lookups are done; see interleaveLanes
+typedef bool (*laneFunction)(schedulerLane &);
+
+// runs a scheduler over a queue it only reads, returning the average seek time; see fifo
+typedef double (*schedulerFunction)(const requestQueue &, int, latencyHistogram *, pathScratch &);
+
+/***************************************************************************
+ * struct schedulerInfo
+ * Date: 17 October 2026
+ * Description: entry of the scheduler registry (see SCHEDULERS), what
+ *--schedulers picks from.
+ **************************************************************************/
+struct schedulerInfo
+{
+  const char *name; // name on the command line
+  const char *label; // column header
+  schedulerFunction run; // batch version, used by the sweep and --trace
+  laneFunction lane; // run as a state machine for --interleave, NULL if it has no lookups worth interleaving
+  bool sorted; // run takes the queue sorted by track instead of in arrival order
+  int online; // policy used by --simulate (ONLINE_FIFO...)
+};
+
+/***************************************************************************
+ * struct rngStream
+ * Date: 17 October 2026
+ * Description: independent random number stream, used in place of rand()
+ *so worker threads never share hidden state. It is a Philox4x32-10 counter
+ *based generator: word i of the stream is a pure function of the key
+ *(the sweep seed) and the counter, so each experiment has its own stream
+ *(see seedStream) and the results do not depend on which thread ran it.
+ **************************************************************************/
+struct rngStream
+{
+  uint32_t key[2]; // seed of the sweep
+  uint32_t counter[4]; // block number (words 0-1), request size (2), experiment (3)
+  uint32_t buffer[4]; // output of the last block generated
+  int used; // words of buffer already handed out
+};
+
+/***************************************************************************
+ * struct addressSet
+ * Date: 17 October 2026
+ * Description: open addressing hash set of disk addresses
+ *(track * 12000 + sector), used to keep generated requests free of duplicates.
+ **************************************************************************/
+struct addressSet
+{
+  vector<uint32_t> slots; // address + 1 of each used slot, 0 if empty
+  uint32_t mask; // number of slots in use - 1 (always a power of two)
+};
+
+/***************************************************************************
+ * struct experimentLane
+ * Date: 17 October 2026
+ * Description: queues and scheduler scratch of one more experiment a
+ *worker runs side by side with its own with --interleave (see runTile,
+ *interleaveLanes).
+ **************************************************************************/
+struct experimentLane
+{
+  requestQueue arrival; // request loaded in arrival order
+  requestQueue sorted; // request loaded in sorted order
+  pathScratch path; // scratch of the schedulers
+};
 
-      // determine if snapback feature should be used
-      if ((trackDistance*.0008) < (1.5 + (currentTrack * .0008))) // if snapback is not faster (slower)
+/***************************************************************************
+ * struct workerArena
+ * Date: 17 October 2026
+ * Description: scratch buffers a worker reuses for every experiment it
+ *runs: the request in arrival order, the permutation of it sorted by track,
+ *the queues the schedulers run on (whose serviced bitmaps are their only
+ *per point state) and the working space of the generators and of the
+ *counting sort. reserveArena sizes them for the largest request once, so
+ *an experiment allocates nothing. The sorted queue is loaded through the
+ *permutation, so the request is never copied into a second point array.
+ **************************************************************************/
+struct workerArena
+{
+  vector<point> request; // request in arrival order
+  vector<uint32_t> order; // indexes of request in sorted order
+  requestQueue arrival; // request loaded in arrival order
+  requestQueue sorted; // request loaded in sorted order
+  addressSet seen; // addresses already in the request
+  vector<uint32_t> draws; // addresses drawn in bulk by generateRequest
+  vector<int> trackStart; // first sorted index of every track, for sortRequest
+  vector<uint32_t> words; // random words drawn in bulk by workloadRequest
+  pathScratch path; // scratch of the schedulers
+  vector<experimentLane> lanes; // the other experiments run side by side with --interleave, see reserveLanes
+};
+
+// fills a request with unique random points, see generateRequest
+typedef void (*generatorFunction)(point[], int, rngStream &, workerArena &);
+
+// stable sort of a request by track into a permutation of its indexes, see sortRequest
+typedef void (*sortFunction)(const point[], int, uint32_t[], workerArena &);
+
+/***************************************************************************
+ * struct simulationOptions
+ * Date: 17 October 2026
+ * Description: options read from the command line by parseOptions.
+ **************************************************************************/
+struct simulationOptions
+{
+  int experiments; // number of experiments per request size
+  int firstSize; // smallest request size of the sweep
+  int lastSize; // largest request size of the sweep
+  int threads; // number of worker threads
+  uint64_t seed; // seed every random stream is derived from
+  bool scaling; // run the scaling report before writing results
+  bool quiet; // suppress progress output
+  bool benchSstf; // run the sstf benchmark instead of a sweep
+  bool benchSort; // run the sort benchmark instead of a sweep
+  bool benchKernel; // run the seek cost kernel benchmark instead of a sweep
+  bool benchInterleave; // run the interleaved scheduler benchmark instead of a sweep
+  bool bench; // run the benchmark suite instead of a sweep
+  bool checkOrder; // check the schedulers do not depend on the order they run in, instead of a sweep
+  bool checkTrace; // check the trace parsers against fixture lines, instead of a sweep
+  const char *benchFilter; // only run the suite's cases whose names contain this, or NULL
+  double benchMinMs; // shortest time of one timed repetition of a suite case
+  const char *benchBaseline; // JSON of an earlier suite run to compare against, or NULL
+  bool profile; // report the time of every phase of the sweep
+  bool percentiles; // record service times in the sweep for the percentile columns and table
+  bool perf; // add hardware counters to --profile and --bench
+  const char *json; // file the --bench or --profile results are written to as JSON, or NULL
+  const char *results; // file the results of the sweep are written to (.dscol for the columnar format)
+  const char *raw; // file every experiment's results are written to, or NULL
+  const char *readResults; // columnar results file to print instead of running a sweep, or NULL
+  const char *checkpoint; // file the fixed sweep saves its progress to, or NULL
+  const char *shared; // region file the fixed sweep is shared through with other processes, or NULL
+  const char *status; // region file of a shared sweep to report on instead of running a sweep, or NULL
+  double checkpointSeconds; // least time between two checkpoints
+  bool resume; // continue the sweep saved in checkpoint
+  int raid; // raid level of the array simulated by --simulate (0, 1, 5 or 10), -1 for one disk
+  int disks; // spindles in the array
+  int stripeUnit; // sectors of a stripe unit
+  int requestSectors; // sectors of a random logical request
+  double writeFraction; // share of random logical requests that are writes
+  sortFunction sorter; // sorting stage for the schedulers that take a sorted queue
+  vector<const schedulerInfo *> schedulers; // schedulers run, in column order
+  int nstep; // requests per batch of nstep
+  int interleave; // experiments a worker runs side by side on its core (see runTile), 1 for back to back
+  generatorFunction generator; // request generator
+  const char *trace; // trace to replay instead of running a sweep, or NULL
+  const char *traceFormat; // format of the trace, NULL to guess from the name
+  const char *traceOut; // binary trace to write the replayed records to, or NULL
+  int window; // number of trace requests the schedulers see at once
+  uint64_t lbasPerSector; // trace blocks per simulated sector
+  long simulate; // requests per scheduler in the event driven simulation, 0 to run a sweep
+  int arrival; // arrival process of the event driven simulation
+  double rate; // average arrival rate in requests per millisecond
+  double onMs; // average length of an ON period of onoff arrivals
+  double offMs; // average length of an OFF period of onoff arrivals
+  double ciTarget; // confidence interval half width the adaptive sweep stops at, 0 to run a fixed sweep
+  int minExperiments; // experiments of every cell before the adaptive sweep may stop it
+  const char *disk; // disk model file loaded into activeDisk, NULL for classicDisk
+  bool analytic; // run the analytic mode instead of a sweep
+  int samples; // experiments per size of the analytic mode
+};
+
+/***************************************************************************
+ * struct arrayState
+ * Date: 17 October 2026
+ * Description: state shared by the array coordinator and the spindle
+ *workers of one run of simulateArray. Each spindle has a ring of member
+ *requests coming in and one of completions going out; everything else
+ *belongs to one thread until the run is over.
+ **************************************************************************/
+struct arrayState
+{
+  const simulationOptions *opts; // array layout, arrivals and number of requests
+  int policy; // scheduler every spindle runs (ONLINE_FIFO...)
+  unique_ptr<handoffRing[]> toSpindle; // member requests for each spindle
+  unique_ptr<handoffRing[]> fromSpindle; // completed member requests of each spindle
+  vector<latencyHistogram> memberHistogram; // response times of the members of each spindle
+  vector<onlineStats> spindleStats; // totals of each spindle
+  vector<uint64_t> slowest; // logical requests each spindle finished last
+};
+
+/***************************************************************************
+ * struct analyticModel
+ * Date: 17 October 2026
+ * Description: tables of the analytic mode worked out once from the cost
+ *model by buildAnalyticModel.
+ **************************************************************************/
+struct analyticModel
+{
+  vector<double> rotation; // mean rotational latency of a step between points k tracks apart [k]
+  vector<double> seek[NUM_CONTROLS]; // summed seek of every step k tracks long along each control path [path][k]
+  double fifoSeek; // mean seek of a step between two independent points
+  double fifoRotation; // mean rotational latency of a step between two independent points
+  double fifoFirst; // mean time of the first step, from the start track sector 0
+};
+
+/***************************************************************************
+ * struct analyticState
+ * Date: 17 October 2026
+ * Description: state shared by the worker threads of the analytic mode,
+ *which hands out request sizes through an atomic counter.
+ **************************************************************************/
+struct analyticState
+{
+  const simulationOptions *opts; // options the mode was started with
+  const analyticModel *model; // tables worked out from the cost model
+  atomic<int> nextSize; // next request size (less opts.firstSize) to be handed to a worker
+  vector<double> mean; // estimated average seek times [size - opts.firstSize][scheduler]
+  vector<double> halfWidth; // half widths of their 95% confidence intervals
+};
+
+/***************************************************************************
+ * void philoxBlocks(const uint32_t[], const uint32_t[], uint32_t[], int)
+ * Date: 17 October 2026
+ * Description: Philox4x32-10 counter based generator (Salmon et al., "Parallel
+ *random numbers: as easy as 1, 2, 3"). Encrypts blocks consecutive
+ *counters starting at counter (low word first + block number) with key,
+ *writing 4 random words per block to out. Every block is independent of
+ *the others, so the loop has no branches or carried state and can be
+ *vectorized by the compiler.
+ *
+ * Parameters:
+ * key I/P const uint32_t[2]  key of the stream
+ * counter I/P const uint32_t[4]  counter of the first block
+ * out O/P uint32_t[]  4 * blocks random words
+ * blocks I/P int  number of blocks to generate
+ **************************************************************************/
+void philoxBlocks(const uint32_t key[], const uint32_t counter[], uint32_t out[], int blocks)
+{
+  for (int block = 0; block < blocks; block++)
+    {
+      uint64_t low = ((uint64_t)counter[1] << 32 | counter[0]) + block;
+      uint32_t c0 = (uint32_t)low, c1 = (uint32_t)(low >> 32), c2 = counter[2], c3 = counter[3];
+      uint32_t k0 = key[0], k1 = key[1];
+
+      for (int round = 0; round < 10; round++)
+	{
+	  uint64_t p0 = (uint64_t)0xD2511F53u * c0;
+	  uint64_t p1 = (uint64_t)0xCD9E8D57u * c2;
+
+	  c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+	  c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+	  c1 = (uint32_t)p1;
+	  c3 = (uint32_t)p0;
+	  k0 += 0x9E3779B9u;
+	  k1 += 0xBB67AE85u;
+	}
+
+      out[4 * block] = c0;
+      out[4 * block + 1] = c1;
+      out[4 * block + 2] = c2;
+      out[4 * block + 3] = c3;
+    }
+}
+
+/***************************************************************************
+ * void seedStream(rngStream &, uint64_t, int, int)
+ * Date: 17 October 2026
+ * Description: positions rng at the start of the stream belonging to one
+ *experiment and request size. The seed is the Philox key and the
+ *experiment and size are the high words of the counter, so any experiment
+ *can be rerun by index without generating the ones before it.
+ *
+ * Parameters:
+ * rng O/P rngStream&  stream to be seeded
+ * seed I/P uint64_t  seed of the whole sweep
+ * experiment I/P int  experiment number
+ * size I/P int  request size
+ **************************************************************************/
+void seedStream(rngStream &rng, uint64_t seed, int experiment, int size)
+{
+  rng.key[0] = (uint32_t)seed;
+  rng.key[1] = (uint32_t)(seed >> 32);
+  rng.counter[0] = 0;
+  rng.counter[1] = 0;
+  rng.counter[2] = (uint32_t)size;
+  rng.counter[3] = (uint32_t)experiment;
+  rng.used = 4; // buffer is empty
+}
+
+/***************************************************************************
+ * void advanceStream(rngStream &, uint64_t)
+ * Date: 17 October 2026
+ * Description: moves the block counter of rng forward.
+ *
+ * Parameters:
+ * rng I/O rngStream&  stream to be moved
+ * blocks I/P uint64_t  number of blocks to skip
+ **************************************************************************/
+void advanceStream(rngStream &rng, uint64_t blocks)
+{
+  uint64_t low = ((uint64_t)rng.counter[1] << 32 | rng.counter[0]) + blocks;
+
+  rng.counter[0] = (uint32_t)low;
+  rng.counter[1] = (uint32_t)(low >> 32);
+}
+
+/***************************************************************************
+ * uint32_t nextRandom(rngStream &)
+ * Date: 17 October 2026
+ * Description: returns the next 32 random bits of the stream.
+ *
+ * Parameters:
+ * rng I/O rngStream&  stream to draw from
+ **************************************************************************/
+uint32_t nextRandom(rngStream &rng)
+{
+  if (rng.used == 4)
+    {
+      philoxBlocks(rng.key, rng.counter, rng.buffer, 1);
+      advanceStream(rng, 1);
+      rng.used = 0;
+    }
+  return rng.buffer[rng.used++];
+}
+
+/***************************************************************************
+ * void fillRandom(rngStream &, uint32_t[], int)
+ * Date: 17 October 2026
+ * Description: fills out with the next n random words of the stream, the
+ *same words n calls to nextRandom() would return. Whole blocks are
+ *generated straight into out in one batch.
+ *
+ * Parameters:
+ * rng I/O rngStream&  stream to draw from
+ * out O/P uint32_t[]  array to be filled
+ * n I/P int  number of words to generate
+ **************************************************************************/
+void fillRandom(rngStream &rng, uint32_t out[], int n)
+{
+  int i = 0;
+
+  // hand out what is left of the current block first
+  while (i < n && rng.used < 4)
+    {
+      out[i++] = rng.buffer[rng.used++];
+    }
+
+  int blocks = (n - i) / 4;
+  philoxBlocks(rng.key, rng.counter, out + i, blocks);
+  advanceStream(rng, blocks);
+  i += 4 * blocks;
+
+  while (i < n)
+    {
+      out[i++] = nextRandom(rng);
+    }
+}
+
+/***************************************************************************
+ * int uniform(rngStream &, int, int)
+ * Date: 17 October 2026
+ * Description: uniform random number generator, using the rejection method
+ *of the original rand() based uniform() on the 32 bit words of the stream.
+ *
+ * Parameters:
+ * rng I/O rngStream&  stream to draw from
+ * lo I/P int the lower bound of random number range
+ * hi I/P int the upper bound of random number range
+ **************************************************************************/
+int uniform(rngStream &rng, int lo, int hi)
+{
+  uint32_t x;
+  uint32_t y = hi - lo + 1;
+  uint32_t z = 0xFFFFFFFFu / y;
+
+  while (y <= (x = (nextRandom(rng) / z)));
+
+  return x + lo;
+}
+
+/***************************************************************************
+ * void fillUniform(rngStream &, int, int, uint32_t[], int)
+ * Date: 17 October 2026
+ * Description: fills out with n uniform random numbers between lo and hi,
+ *the same numbers n calls to uniform() would return. Random words are made
+ *in bulk with fillRandom() and then scaled in place, rejected words are
+ *replaced by drawing again.
+ *
+ * Parameters:
+ * rng I/O rngStream&  stream to draw from
+ * lo I/P int the lower bound of random number range
+ * hi I/P int the upper bound of random number range
+ * out O/P uint32_t[]  array to be filled
+ * n I/P int  number of values to generate
+ **************************************************************************/
+void fillUniform(rngStream &rng, int lo, int hi, uint32_t out[], int n)
+{
+  uint32_t y = hi - lo + 1;
+  uint32_t z = 0xFFFFFFFFu / y;
+  int filled = 0;
+
+  while (filled < n)
+    {
+      int start = filled;
+
+      fillRandom(rng, out + start, n - start);
+
+      // keep accepted values in order, anything rejected is drawn again
+      for (int i = start; i < n; i++)
+	{
+	  uint32_t x = out[i] / z;
+	  if (x < y)
+	    out[filled++] = x + lo;
+	}
+    }
+}
+
+/***************************************************************************
+ * void swap(point *, point*)
+ * Author: Logan Wheat
+ * Date: 17 November 2019
+ * Description: swaps the perameters, utilized in bubble sort algorithm
+*
+* Parameters:
+* x I/P point*  the first point passed to be swapped with the second
+* y I/P point*  the second point passed to be swapped with the first
+**************************************************************************/
+void swap(point *x, point *y)
+{
+  point temp = *x;
+  *x = *y;
+  *y = temp;
+}
+
+/***************************************************************************
+ * void bubbleSortRequest(const point[], int, uint32_t[], workerArena &)
+ * Author: Logan Wheat
+ * Date: 17 November 2019
+ * Description: sorts the array of points utilizing a bubble sort algorithm
+ *(on their indexes, so the points themselves stay where they are)
+ *
+ * Parameters:
+ * request I/P const point[]  array of points to be sorted (sorted by track in ascending order)
+ * size I/P int  size of array that is to be sorted
+ * order O/P uint32_t[]  indexes of the points in sorted order
+ * arena I/O workerArena&  scratch space (not needed here)
+ **************************************************************************/
+void bubbleSortRequest(const point request[], int size, uint32_t order[], workerArena &/*arena*/)
+{
+  int i, j;
+  for (i = 0; i < size; i++)
+    {
+      order[i] = i;
+    }
+  for (i = 0; i < size - 1; i++)
+    {
+      // Last i elements are already in place  
+      for (j = 0; j < size - i - 1; j++)
+	{
+	  if (request[order[j]].track > request[order[j + 1]].track)
+	    swap(order[j], order[j + 1]);
+	}
+    }
+}
+
+/***************************************************************************
+ * void sortRequest(const point[], int, uint32_t[], workerArena &)
+ * Date: 17 October 2026
+ * Description: sorts the array of points by track in ascending order with
+ *a counting sort, O(n + tracks) instead of O(n^2). Tracks are whole numbers
+ *below the number of tracks so they are used directly as bucket numbers.
+ *Every sorter must be stable (points on the same track keep their arrival
+ *order), since sstf, scan and cscan break ties by index.
+ *
+ * Parameters:
+ * request I/P const point[]  array of points to be sorted (sorted by track in ascending order)
+ * size I/P int  size of array that is to be sorted
+ * order O/P uint32_t[]  indexes of the points in sorted order
+ * arena I/O workerArena&  holds the bucket starts, grown once to the number of tracks
+ **************************************************************************/
+void sortRequest(const point request[], int size, uint32_t order[], workerArena &arena)
+{
+  if ((int)arena.trackStart.size() < activeDisk.tracks + 1)
+    arena.trackStart.resize(activeDisk.tracks + 1);
+  int *start = arena.trackStart.data(); // first output index of every track
+  fill(start, start + activeDisk.tracks + 1, 0);
+
+  // count the points on each track, then turn the counts into start indexes
+  for (int i = 0; i < size; i++)
+    {
+      start[(int)request[i].track + 1]++;
+    }
+  for (int track = 0; track < activeDisk.tracks; track++)
+    {
+      start[track + 1] += start[track];
+    }
+
+  // place indexes in arrival order so the sort is stable
+  for (int i = 0; i < size; i++)
+    {
+      order[start[(int)request[i].track]++] = i;
+    }
+}
+
+/***************************************************************************
+ * void stableSortRequest(const point[], int, uint32_t[], workerArena &)
+ * Date: 17 October 2026
+ * Description: sorts the array of points by track with std::sort, for
+ *tracks that are not whole numbers. Ties are broken by index, which makes
+ *it stable without the buffer std::stable_sort would allocate.
+ *
+ * Parameters:
+ * request I/P const point[]  array of points to be sorted (sorted by track in ascending order)
+ * size I/P int  size of array that is to be sorted
+ * order O/P uint32_t[]  indexes of the points in sorted order
+ * arena I/O workerArena&  scratch space (not needed here)
+ **************************************************************************/
+void stableSortRequest(const point request[], int size, uint32_t order[], workerArena &/*arena*/)
+{
+  for (int i = 0; i < size; i++)
+    {
+      order[i] = i;
+    }
+  sort(order, order + size, [request](uint32_t a, uint32_t b) {
+    return request[a].track < request[b].track || (request[a].track == request[b].track && a < b);
+  });
+}
+
+/***************************************************************************
+ * sortFunction findSorter(const char *)
+ * Date: 17 October 2026
+ * Description: looks up a sorting stage by name (counting, bubble or std).
+ *
+ * Parameters:
+ * name I/P const char*  name of the sorter
+ * findSorter O/P sortFunction  the sorter, NULL if the name is not known
+ **************************************************************************/
+sortFunction findSorter(const char *name)
+{
+  if (strcmp(name, "counting") == 0)
+    return sortRequest;
+  if (strcmp(name, "bubble") == 0)
+    return bubbleSortRequest;
+  if (strcmp(name, "std") == 0)
+    return stableSortRequest;
+  return NULL;
+}
+
+/***************************************************************************
+ * void outputRequest(point[], int)
+ * Author: Logan Wheat
+ * Date: 15 November 2019
+ * Description: outputs all the track and sector pairs of a point array size(requestSize)
+ *
+ * Parameters:
+ * request I/P point[]  array of points to be sent to standard output
+ * requestSize I/P int  The size of the array to be output
+ **************************************************************************/
+void outputRequest(point request[], int requestSize)
+{
+  cout << "Track\tSector" << endl;
+  for (int i = 0; i < requestSize; i++)
+    {
+      cout << i << ": " << request[i].track << "\t" << request[i].sector << endl;
+    }
+}
+
+/***************************************************************************
+ * void resizeQueue(requestQueue &, int)
+ * Date: 17 October 2026
+ * Description: sets the number of points in queue and marks them all as not
+ *accessed. The arrays only ever grow, so a queue reused between experiments
+ *stops allocating once it has held the largest request.
+ *
+ * Parameters:
+ * queue I/O requestQueue&  queue to be resized
+ * size I/P int  new number of points
+ **************************************************************************/
+void resizeQueue(requestQueue &queue, int size)
+{
+  int words = (size + 63) / 64;
+
+  if ((int)queue.track.size() < size)
+    {
+      queue.track.resize(size);
+      queue.sector.resize(size);
+    }
+  if ((int)queue.serviced.size() < words)
+    queue.serviced.resize(words);
+
+  queue.size = size;
+  fill(queue.serviced.begin(), queue.serviced.begin() + words, 0);
+}
+
+/***************************************************************************
+ * bool isServiced(const requestQueue &, int)
+ * Date: 17 October 2026
+ * Description: returns whether point i of queue has been accessed.
+ *
+ * Parameters:
+ * queue I/P const requestQueue&  queue the point is in
+ * i I/P int  index of the point
+ **************************************************************************/
+inline bool isServiced(const requestQueue &queue, int i)
+{
+  return (queue.serviced[i >> 6] >> (i & 63)) & 1;
+}
+
+/***************************************************************************
+ * void markServiced(requestQueue &, int)
+ * Date: 17 October 2026
+ * Description: marks point i of queue as accessed.
+ *
+ * Parameters:
+ * queue I/O requestQueue&  queue the point is in
+ * i I/P int  index of the point
+ **************************************************************************/
+inline void markServiced(requestQueue &queue, int i)
+{
+  queue.serviced[i >> 6] |= (uint64_t)1 << (i & 63);
+}
+
+/***************************************************************************
+ * void loadQueue(requestQueue &, const point[], int)
+ * Date: 17 October 2026
+ * Description: copies an array of points into queue. Tracks and sectors
+ *must be whole numbers in range.
+ *
+ * Parameters:
+ * queue O/P requestQueue&  queue to be filled
+ * request I/P const point[]  array of points to be copied
+ * size I/P int  number of points
+ **************************************************************************/
+void loadQueue(requestQueue &queue, const point request[], int size)
+{
+  resizeQueue(queue, size);
+  for (int i = 0; i < size; i++)
+    {
+      queue.track[i] = (uint16_t)request[i].track;
+      queue.sector[i] = (uint16_t)request[i].sector;
+      if (request[i].accessed)
+	markServiced(queue, i);
+    }
+}
+
+/***************************************************************************
+ * void loadSortedQueue(requestQueue &, const point[], const uint32_t[], int)
+ * Date: 17 October 2026
+ * Description: copies an array of points into queue in the order given by
+ *a sorter's permutation. Tracks and sectors must be whole numbers in range.
+ *
+ * Parameters:
+ * queue O/P requestQueue&  queue to be filled
+ * request I/P const point[]  array of points to be copied
+ * order I/P const uint32_t[]  indexes of the points in the order they are loaded
+ * size I/P int  number of points
+ **************************************************************************/
+void loadSortedQueue(requestQueue &queue, const point request[], const uint32_t order[], int size)
+{
+  resizeQueue(queue, size);
+  for (int i = 0; i < size; i++)
+    {
+      const point &p = request[order[i]];
+
+      queue.track[i] = (uint16_t)p.track;
+      queue.sector[i] = (uint16_t)p.sector;
+      if (p.accessed)
+	markServiced(queue, i);
+    }
+}
+
+/***************************************************************************
+ * void storeQueue(const requestQueue &, point[])
+ * Date: 17 October 2026
+ * Description: copies queue back out into an array of points.
+ *
+ * Parameters:
+ * queue I/P const requestQueue&  queue to be copied
+ * request O/P point[]  array of at least queue.size points
+ **************************************************************************/
+void storeQueue(const requestQueue &queue, point request[])
+{
+  for (int i = 0; i < queue.size; i++)
+    {
+      request[i].track = queue.track[i];
+      request[i].sector = queue.sector[i];
+      request[i].accessed = isServiced(queue, i);
+    }
+}
+
+/***************************************************************************
+ * void clearHistogram(latencyHistogram &)
+ * Date: 17 October 2026
+ * Description: empties a histogram.
+ *
+ * Parameters:
+ * histogram O/P latencyHistogram&  histogram to be emptied
+ **************************************************************************/
+void clearHistogram(latencyHistogram &histogram)
+{
+  memset(&histogram, 0, sizeof(histogram));
+}
+
+/***************************************************************************
+ * int histogramBucket(double)
+ * Date: 17 October 2026
+ * Description: bucket of a value in milliseconds. The value is rounded to
+ *whole microseconds; from 128 up the bucket is read straight out of the
+ *bits of the double (the exponent and the top 6 bits of the mantissa),
+ *which skips converting to an integer. Bucket edges are whole numbers so
+ *rounding first cannot move a value across one.
+ *
+ * Parameters:
+ * value I/P double  value in milliseconds, not negative
+ * histogramBucket O/P int  bucket number, values past the last bucket go in it
+ **************************************************************************/
+inline int histogramBucket(double value)
+{
+  double micros = value * 1000 + 0.5;
+  uint64_t bits;
+  int bucket;
+
+  if (micros < 128)
+    return (int)micros;
+
+  memcpy(&bits, &micros, sizeof(bits));
+  bucket = (int)(bits >> 46) - ((1023 + 5) << 6); // (exponent - 5) * 64 + top 6 mantissa bits
+  return bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1;
+}
+
+/***************************************************************************
+ * double bucketValue(int)
+ * Date: 17 October 2026
+ * Description: value a bucket stands for (the middle of its range) in
+ *milliseconds.
+ *
+ * Parameters:
+ * bucket I/P int  bucket number
+ **************************************************************************/
+double bucketValue(int bucket)
+{
+  if (bucket < 128)
+    return bucket / 1000.0;
+
+  int shift = bucket / 64 - 1;
+  uint64_t low = (uint64_t)(bucket % 64 + 64) << shift;
+  return (low + ((uint64_t)1 << shift) / 2.0) / 1000.0;
+}
+
+/***************************************************************************
+ * void recordLatency(latencyHistogram &, double)
+ * Date: 17 October 2026
+ * Description: adds one value to a histogram.
+ *
+ * Parameters:
+ * histogram I/O latencyHistogram&  histogram the value is added to
+ * value I/P double  value in milliseconds
+ **************************************************************************/
+inline void recordLatency(latencyHistogram &histogram, double value)
+{
+  histogram.counts[histogramBucket(value)]++;
+  histogram.total++;
+  histogram.sum += value;
+  if (value > histogram.max)
+    histogram.max = value;
+}
+
+/***************************************************************************
+ * void recordPath(latencyHistogram &, const double[], int, double)
+ * Date: 17 October 2026
+ * Description: adds the time of every step of a path to a histogram. Does
+ *the same as calling recordLatency() for each step, but keeps the max in a
+ *register and takes the sum the caller already has, so the only memory
+ *traffic left is the bucket counts.
+ *
+ * Parameters:
+ * histogram I/O latencyHistogram&  histogram the values are added to
+ * stepTime I/P const double[]  time of every step in milliseconds
+ * n I/P int  number of steps
+ * sum I/P double  sum of all the steps in milliseconds
+ **************************************************************************/
+void recordPath(latencyHistogram &histogram, const double stepTime[], int n, double sum)
+{
+  uint64_t *counts = histogram.counts;
+  double largest = histogram.max;
+
+  for (int i = 0; i < n; i++)
+    {
+      double value = stepTime[i];
+
+      counts[histogramBucket(value)]++;
+      largest = max(largest, value);
+    }
+  histogram.total += n;
+  histogram.sum += sum;
+  histogram.max = largest;
+}
+
+/***************************************************************************
+ * void mergeHistogram(latencyHistogram &, const latencyHistogram &)
+ * Date: 17 October 2026
+ * Description: adds every value recorded in from into into. Counts are
+ *whole numbers, so histograms merged in any order give the same buckets.
+ *
+ * Parameters:
+ * into I/O latencyHistogram&  histogram the values are added to
+ * from I/P const latencyHistogram&  histogram to be added
+ **************************************************************************/
+void mergeHistogram(latencyHistogram &into, const latencyHistogram &from)
+{
+  for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++)
+    {
+      into.counts[bucket] += from.counts[bucket];
+    }
+  into.total += from.total;
+  into.sum += from.sum;
+  into.max = max(into.max, from.max);
+}
+
+/***************************************************************************
+ * double latencyPercentile(const latencyHistogram &, double)
+ * Date: 17 October 2026
+ * Description: value below which percent of the recorded values fall.
+ *
+ * Parameters:
+ * histogram I/P const latencyHistogram&  histogram to be read
+ * percent I/P double  percentile wanted, 0-100
+ * latencyPercentile O/P double  value in milliseconds, 0 if the histogram is empty
+ **************************************************************************/
+double latencyPercentile(const latencyHistogram &histogram, double percent)
+{
+  uint64_t rank = (uint64_t)ceil(percent / 100 * histogram.total);
+  uint64_t seen = 0;
+
+  if (histogram.total == 0)
+    return 0;
+  if (rank == 0)
+    rank = 1;
+
+  for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++)
+    {
+      seen += histogram.counts[bucket];
+      if (seen >= rank)
+	return min(bucketValue(bucket), histogram.max);
+    }
+  return histogram.max;
+}
+
+/***************************************************************************
+ * void addSample(runningStat &, double)
+ * Date: 17 October 2026
+ * Description: adds one sample to a running mean and variance (Welford's
+ *method, which stays accurate where summing squares would cancel).
+ *
+ * Parameters:
+ * stat I/O runningStat&  running statistics
+ * value I/P double  sample to be added
+ **************************************************************************/
+inline void addSample(runningStat &stat, double value)
+{
+  double delta = value - stat.mean;
+
+  stat.count++;
+  stat.mean += delta / stat.count;
+  stat.m2 += delta * (value - stat.mean);
+}
+
+/***************************************************************************
+ * void mergeStat(runningStat &, const runningStat &)
+ * Date: 17 October 2026
+ * Description: adds the samples summed up in from into into (the pairwise
+ *update of Chan, Golub and LeVeque). The result depends on the order
+ *statistics are merged in, so callers merge in a fixed order.
+ *
+ * Parameters:
+ * into I/O runningStat&  statistics the samples are added to
+ * from I/P const runningStat&  statistics to be added
+ **************************************************************************/
+void mergeStat(runningStat &into, const runningStat &from)
+{
+  long count = into.count + from.count;
+
+  if (from.count == 0)
+    return;
+
+  double delta = from.mean - into.mean;
+  into.mean += delta * from.count / count;
+  into.m2 += from.m2 + delta * delta * ((double)into.count * from.count / count);
+  into.count = count;
+}
+
+/***************************************************************************
+ * double statHalfWidth(const runningStat &)
+ * Date: 17 October 2026
+ * Description: half width of the 95% confidence interval of the mean.
+ *
+ * Parameters:
+ * stat I/P const runningStat&  running statistics
+ * statHalfWidth O/P double  half width in milliseconds, HUGE_VAL below 2 samples
+ **************************************************************************/
+double statHalfWidth(const runningStat &stat)
+{
+  if (stat.count < 2)
+    return HUGE_VAL;
+  return (CONFIDENCE_Z * sqrt(stat.m2 / (stat.count - 1) / stat.count));
+}
+
+/***************************************************************************
+ * void outputPercentiles(ostream &, const latencyHistogram[], int, const vector<const schedulerInfo *> &)
+ * Date: 17 October 2026
+ * Description: prints a table of the mean, p50, p90, p99, p99.9 and max of
+ *every scheduler's histogram(s). With more than one histogram per
+ *scheduler (one per request size for example) they are merged first.
+ *
+ * Parameters:
+ * out I/O ostream&  stream the table is printed to
+ * histogram I/P const latencyHistogram[]  histograms [group][scheduler]
+ * groups I/P int  number of histograms per scheduler
+ * schedulers I/P const vector<const schedulerInfo *>&  schedulers the histograms belong to
+ **************************************************************************/
+void outputPercentiles(ostream &out, const latencyHistogram histogram[], int groups, const vector<const schedulerInfo *> &schedulers)
+{
+  int count = schedulers.size();
+  latencyHistogram merged;
+
+  out << "Scheduler\tRequests\tMean\t\tp50\tp90\tp99\tp99.9\tMax\n";
+  for (int alg = 0; alg < count; alg++)
+    {
+      clearHistogram(merged);
+      for (int group = 0; group < groups; group++)
+	{
+	  mergeHistogram(merged, histogram[group * count + alg]);
+	}
+
+      out << schedulers[alg]->label << "\t\t" << merged.total << "\t\t" << (merged.total > 0 ? merged.sum / merged.total : 0) << "\t";
+      for (int p = 0; p < NUM_PERCENTILES; p++)
+	{
+	  out << "\t" << latencyPercentile(merged, PERCENTILES[p]);
+	}
+      out << "\t" << merged.max << "\n";
+    }
+}
+
+/***************************************************************************
+ * bool openPerfCounters(perfCounters &)
+ * Date: 17 October 2026
+ * Description: opens the cycle, instruction, cache miss and branch miss
+ *counters of the calling thread as one group and starts them. If any of
+ *them cannot be opened none are kept and errno says why.
+ *
+ * Parameters:
+ * perf O/P perfCounters&  counters opened
+ * openPerfCounters O/P bool  true if every counter was opened
+ **************************************************************************/
+bool openPerfCounters(perfCounters &perf)
+{
+  perf.open = false;
+#ifdef __linux__
+  const uint64_t config[NUM_PERF_COUNTERS] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+					       PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+
+  for (int i = 0; i < NUM_PERF_COUNTERS; i++)
+    {
+      perf_event_attr attr;
+
+      memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = config[i];
+      attr.read_format = PERF_FORMAT_GROUP;
+      attr.disabled = (i == 0); // the group starts when its leader is enabled
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+
+      perf.fd[i] = syscall(SYS_perf_event_open, &attr, 0, -1, (i == 0) ? -1 : perf.fd[0], 0);
+      if (perf.fd[i] < 0)
+	{
+	  int error = errno;
+
+	  while (--i >= 0)
+	    close(perf.fd[i]);
+	  errno = error;
+	  return false;
+	}
+    }
+
+  ioctl(perf.fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(perf.fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  perf.open = true;
+  return true;
+#else
+  errno = ENOSYS;
+  return false;
+#endif
+}
+
+/***************************************************************************
+ * void readPerfCounters(const perfCounters &, uint64_t[])
+ * Date: 17 October 2026
+ * Description: reads every counter of the group at once. Counts are all 0
+ *if the counters are not open.
+ *
+ * Parameters:
+ * perf I/P const perfCounters&  counters to be read
+ * out O/P uint64_t[]  count of each counter, NUM_PERF_COUNTERS of them
+ **************************************************************************/
+void readPerfCounters(const perfCounters &perf, uint64_t out[])
+{
+  uint64_t group[1 + NUM_PERF_COUNTERS] = { 0 }; // number of counters, then their counts
+
+#ifdef __linux__
+  if (perf.open && read(perf.fd[0], group, sizeof(group)) != (ssize_t)sizeof(group))
+    memset(group, 0, sizeof(group));
+#endif
+  copy(group + 1, group + 1 + NUM_PERF_COUNTERS, out);
+}
+
+/***************************************************************************
+ * void closePerfCounters(perfCounters &)
+ * Date: 17 October 2026
+ * Description: closes the counters, if they are open.
+ *
+ * Parameters:
+ * perf I/O perfCounters&  counters to be closed
+ **************************************************************************/
+void closePerfCounters(perfCounters &perf)
+{
+#ifdef __linux__
+  for (int i = 0; perf.open && i < NUM_PERF_COUNTERS; i++)
+    {
+      close(perf.fd[i]);
+    }
+#endif
+  perf.open = false;
+}
+
+/***************************************************************************
+ * void clearProfile(phaseProfile &, const vector<const schedulerInfo *> &)
+ * Date: 17 October 2026
+ * Description: empties a profile and names its phases: generate, sort,
+ *load and then one per scheduler run. The counters are left closed.
+ *
+ * Parameters:
+ * profile O/P phaseProfile&  profile to be cleared
+ * schedulers I/P const vector<const schedulerInfo *>&  schedulers of the sweep
+ **************************************************************************/
+void clearProfile(phaseProfile &profile, const vector<const schedulerInfo *> &schedulers)
+{
+  int phases = PHASE_SCHEDULER + schedulers.size();
+
+  profile.names.assign({ "generate", "sort", "load" });
+  for (const schedulerInfo *scheduler : schedulers)
+    {
+      profile.names.push_back(scheduler->name);
+    }
+  profile.calls.assign(phases, 0);
+  profile.ns.assign(phases, 0);
+  profile.items.assign(phases, 0);
+  profile.counters.assign((size_t)phases * NUM_PERF_COUNTERS, 0);
+  profile.perf.open = false;
+}
+
+/***************************************************************************
+ * void mergeProfile(phaseProfile &, const phaseProfile &)
+ * Date: 17 October 2026
+ * Description: adds the times and counts of one profile into another with
+ *the same phases.
+ *
+ * Parameters:
+ * into I/O phaseProfile&  profile added into
+ * from I/P const phaseProfile&  profile added
+ **************************************************************************/
+void mergeProfile(phaseProfile &into, const phaseProfile &from)
+{
+  for (size_t phase = 0; phase < into.names.size(); phase++)
+    {
+      into.calls[phase] += from.calls[phase];
+      into.ns[phase] += from.ns[phase];
+      into.items[phase] += from.items[phase];
+    }
+  for (size_t i = 0; i < into.counters.size(); i++)
+    {
+      into.counters[i] += from.counters[i];
+    }
+}
+
+/***************************************************************************
+ * scopedTimer::scopedTimer(phaseProfile *, int, long)
+ * scopedTimer::~scopedTimer()
+ * Date: 17 October 2026
+ * Description: the constructor notes the hardware counts and then the
+ *time, the destructor takes the time first and then the counts and adds
+ *the differences to the phase, so reading the counters is not part of the
+ *time.
+ *
+ * Parameters:
+ * profile I/O phaseProfile*  profile added to, NULL to do nothing
+ * phase I/P int  phase the time goes to
+ * items I/P long  requests handled in the scope
+ **************************************************************************/
+scopedTimer::scopedTimer(phaseProfile *profile, int phase, long items) : profile(profile), phase(phase), items(items)
+{
+  if (profile == NULL)
+    return;
+  if (profile->perf.open)
+    readPerfCounters(profile->perf, counters);
+  start = chrono::steady_clock::now();
+}
+
+scopedTimer::~scopedTimer()
+{
+  if (profile == NULL)
+    return;
+
+  auto end = chrono::steady_clock::now();
+
+  profile->calls[phase]++;
+  profile->ns[phase] += chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+  profile->items[phase] += items;
+  if (profile->perf.open)
+    {
+      uint64_t now[NUM_PERF_COUNTERS];
+
+      readPerfCounters(profile->perf, now);
+      for (int c = 0; c < NUM_PERF_COUNTERS; c++)
+	{
+	  profile->counters[(size_t)phase * NUM_PERF_COUNTERS + c] += now[c] - counters[c];
+	}
+    }
+}
+
+/***************************************************************************
+ * void outputProfile(ostream &, const phaseProfile &, double, bool)
+ * Date: 17 October 2026
+ * Description: prints the calls, thread seconds, share of the total and
+ *requests per second of every phase of a sweep and, with hardware
+ *counters, instructions per cycle and cache and branch misses per request.
+ *
+ * Parameters:
+ * out I/O ostream&  stream the table is printed to
+ * profile I/P const phaseProfile&  profile of the sweep
+ * seconds I/P double  wall clock time of the sweep
+ * perf I/P bool  the profile has hardware counts
+ **************************************************************************/
+void outputProfile(ostream &out, const phaseProfile &profile, double seconds, bool perf)
+{
+  uint64_t totalNs = 0;
+
+  for (uint64_t ns : profile.ns)
+    {
+      totalNs += ns;
+    }
+
+  out << "Phase profile, " << (totalNs / 1e9) << " thread seconds in " << seconds << " wall seconds\n"
+      << "Phase\t\tCalls\tSeconds\t\tShare\tRequests/s" << (perf ? "\tIPC\tCache misses/req\tBranch misses/req" : "") << "\n";
+  for (size_t phase = 0; phase < profile.names.size(); phase++)
+    {
+      const uint64_t *count = &profile.counters[phase * NUM_PERF_COUNTERS];
+      double phaseSeconds = profile.ns[phase] / 1e9;
+      double items = max<uint64_t>(1, profile.items[phase]);
+
+      out << profile.names[phase] << (profile.names[phase].size() < 8 ? "\t\t" : "\t") << profile.calls[phase] << "\t"
+	  << phaseSeconds << "\t\t" << (totalNs > 0 ? 100.0 * profile.ns[phase] / totalNs : 0) << "%\t"
+	  << (phaseSeconds > 0 ? profile.items[phase] / phaseSeconds : 0);
+      if (perf)
+	out << "\t" << (count[0] > 0 ? (double)count[1] / count[0] : 0) << "\t" << (count[2] / items) << "\t\t\t"
+	    << (count[3] / items);
+      out << "\n";
+    }
+}
+
+/***************************************************************************
+ * void outputJsonString(ostream &, const string &)
+ * Date: 17 October 2026
+ * Description: prints a string as a quoted JSON string.
+ *
+ * Parameters:
+ * out I/O ostream&  stream the string is printed to
+ * text I/P const string&  string to be printed
+ **************************************************************************/
+void outputJsonString(ostream &out, const string &text)
+{
+  out << '"';
+  for (unsigned char c : text)
+    {
+      if (c == '"' || c == '\\')
+	out << '\\' << c;
+      else if (c < 0x20)
+	{
+	  const char *hex = "0123456789abcdef";
+	  out << "\\u00" << hex[c >> 4] << hex[c & 15];
+	}
+      else
+	out << c;
+    }
+  out << '"';
+}
+
+/***************************************************************************
+ * void outputJsonContext(ostream &, const simulationOptions &)
+ * Date: 17 October 2026
+ * Description: prints the "context" member every JSON report starts with:
+ *what was run and how the program was built, so reports from different
+ *versions or machines can be told apart before they are compared.
+ *
+ * Parameters:
+ * out I/O ostream&  stream the member is printed to
+ * opts I/P const simulationOptions&  options of the run
+ **************************************************************************/
+void outputJsonContext(ostream &out, const simulationOptions &opts)
+{
+#if defined(__AVX512F__)
+  const char *kernel = "avx512";
+#elif defined(__AVX2__)
+  const char *kernel = "avx2";
+#else
+  const char *kernel = "scalar";
+#endif
+
+  out << "  \"context\": {\n"
+      << "    \"threads\": " << opts.threads << ",\n"
+      << "    \"seed\": " << opts.seed << ",\n"
+      << "    \"experiments\": " << opts.experiments << ",\n"
+      << "    \"disk\": ";
+  outputJsonString(out, opts.disk != NULL ? opts.disk : "classic");
+  out << ",\n"
+      << "    \"kernel\": \"" << kernel << "\",\n"
+      << "    \"hardware_counters\": " << (opts.perf ? "true" : "false") << ",\n"
+      << "    \"compiler\": ";
+  outputJsonString(out, __VERSION__);
+  out << "\n  },\n";
+}
+
+/***************************************************************************
+ * bool writeProfileJson(const char *, const simulationOptions &, const phaseProfile &, double)
+ * Date: 17 October 2026
+ * Description: writes the phase profile of a sweep as JSON (--profile
+ *--json FILE), one object per phase.
+ *
+ * Parameters:
+ * path I/P const char*  file to be written
+ * opts I/P const simulationOptions&  options of the sweep
+ * profile I/P const phaseProfile&  profile of the sweep
+ * seconds I/P double  wall clock time of the sweep
+ * writeProfileJson O/P bool  false if the file could not be written
+ **************************************************************************/
+bool writeProfileJson(const char *path, const simulationOptions &opts, const phaseProfile &profile, double seconds)
+{
+  ofstream out(path);
+
+  out << "{\n";
+  outputJsonContext(out, opts);
+  out << "  \"wall_seconds\": " << seconds << ",\n"
+      << "  \"phases\": [\n";
+  for (size_t phase = 0; phase < profile.names.size(); phase++)
+    {
+      double phaseSeconds = profile.ns[phase] / 1e9;
+
+      out << "    {\"name\": ";
+      outputJsonString(out, profile.names[phase]);
+      out << ", \"calls\": " << profile.calls[phase] << ", \"seconds\": " << phaseSeconds
+	  << ", \"requests\": " << profile.items[phase]
+	  << ", \"requests_per_second\": " << (phaseSeconds > 0 ? profile.items[phase] / phaseSeconds : 0);
+      for (int c = 0; opts.perf && c < NUM_PERF_COUNTERS; c++)
+	{
+	  out << ", \"" << PERF_COUNTER_NAMES[c] << "\": " << profile.counters[phase * NUM_PERF_COUNTERS + c];
+	}
+      out << "}" << (phase + 1 < profile.names.size() ? "," : "") << "\n";
+    }
+  out << "  ]\n}\n";
+
+  out.close();
+  if (!out)
+    {
+      cerr << "could not write " << path << "\n";
+      return false;
+    }
+  return true;
+}
+
+/***************************************************************************
+ * bool openSink(resultsSink &, const char *, const vector<string> &, const string &)
+ * Date: 17 October 2026
+ * Description: creates a results file with the given columns. Files whose
+ *name ends in .dscol are written in the columnar format (see resultsSink),
+ *anything else as comma separated text with a header line.
+ *
+ * Parameters:
+ * sink O/P resultsSink&  sink to be opened
+ * path I/P const char*  file to be written
+ * names I/P const vector<string>&  name of each column
+ * types I/P const string&  type of each column, 'i' for whole numbers and 'd' for doubles
+ * openSink O/P bool  false if the file could not be created
+ **************************************************************************/
+bool openSink(resultsSink &sink, const char *path, const vector<string> &names, const string &types)
+{
+  size_t length = strlen(path);
+
+  sink.columnar = (length >= 6 && strcmp(path + length - 6, ".dscol") == 0);
+  sink.file = fopen(path, "wb");
+  sink.names = names;
+  sink.types = types;
+  sink.text.clear();
+  sink.group.clear();
+  sink.groupRows.clear();
+  sink.groupOffsets.clear();
+  sink.offset = 0;
+  sink.rows = 0;
+  sink.failed = (sink.file == NULL);
+  if (sink.failed)
+    {
+      cerr << "could not create " << path << "\n";
+      return false;
+    }
+
+  if (sink.columnar)
+    {
+      fwrite(COLUMNAR_MAGIC, 1, sizeof(COLUMNAR_MAGIC), sink.file);
+      sink.offset = sizeof(COLUMNAR_MAGIC);
+    }
+  else
+    {
+      for (size_t c = 0; c < names.size(); c++)
+	{
+	  sink.text.insert(sink.text.end(), names[c].begin(), names[c].end());
+	  sink.text.push_back(c + 1 < names.size() ? ',' : '\n');
+	  if (c + 1 < names.size())
+	    sink.text.push_back(' ');
+	}
+    }
+  return true;
+}
+
+/***************************************************************************
+ * bool sinkWritable(const char *)
+ * Date: 17 October 2026
+ * Description: checks that a results file can be created before the run
+ *whose results go in it, so a bad path fails at once instead of after
+ *the sweep. Opens the file for appending, which leaves what is there
+ *alone: with --shared the process that writes the results may already
+ *have done so.
+ *
+ * Parameters:
+ * path I/P const char*  file that will be written
+ * sinkWritable O/P bool  false, with a message on cerr, if it cannot be
+ **************************************************************************/
+bool sinkWritable(const char *path)
+{
+  FILE *file = fopen(path, "ab");
+
+  if (file == NULL)
+    {
+      cerr << "could not create " << path << "\n";
+      return false;
+    }
+  fclose(file);
+  return true;
+}
+
+/***************************************************************************
+ * void flushSinkGroup(resultsSink &)
+ * Date: 17 October 2026
+ * Description: writes the rows waiting in a columnar sink as one row
+ *group, a column at a time, and notes where the group starts for the
+ *footer. The caller holds the sink's lock.
+ *
+ * Parameters:
+ * sink I/O resultsSink&  columnar sink
+ **************************************************************************/
+void flushSinkGroup(resultsSink &sink)
+{
+  size_t columns = sink.names.size();
+  uint64_t rows = sink.group.size() / columns;
+  vector<uint64_t> chunk(rows); // one column, as written
+
+  if (rows == 0)
+    return;
+
+  sink.groupRows.push_back(rows);
+  sink.groupOffsets.push_back(sink.offset);
+  for (size_t c = 0; c < columns; c++)
+    {
+      for (uint64_t r = 0; r < rows; r++)
+	{
+	  double value = sink.group[r * columns + c];
+
+	  if (sink.types[c] == 'i')
+	    {
+	      int64_t whole = (int64_t)value;
+	      memcpy(&chunk[r], &whole, 8);
+	    }
+	  else
+	    memcpy(&chunk[r], &value, 8);
+	}
+      fwrite(chunk.data(), 8, rows, sink.file);
+    }
+  sink.offset += rows * columns * 8;
+  sink.group.clear();
+}
+
+/***************************************************************************
+ * void sinkRows(resultsSink &, const double[], int)
+ * Date: 17 October 2026
+ * Description: adds rows to a results file. Safe to call from any number
+ *of threads at once; each call's rows stay together. Text is formatted
+ *into a buffer written out every SINK_BUFFER_BYTES (doubles as %g, like
+ *the stream output they replace) and columnar rows are written out every
+ *SINK_GROUP_ROWS rows, so a sink never holds more than that.
+ *
+ * Parameters:
+ * sink I/O resultsSink&  sink to be written to
+ * values I/P const double[]  the rows, one value per column in column order
+ * rows I/P int  number of rows
+ **************************************************************************/
+void sinkRows(resultsSink &sink, const double values[], int rows)
+{
+  size_t columns = sink.names.size();
+  lock_guard<mutex> lock(sink.lock);
+
+  if (sink.file == NULL)
+    return;
+  sink.rows += rows;
+
+  if (sink.columnar)
+    {
+      for (int r = 0; r < rows; r++)
+	{
+	  sink.group.insert(sink.group.end(), values + r * columns, values + (r + 1) * columns);
+	  if (sink.group.size() >= SINK_GROUP_ROWS * columns)
+	    flushSinkGroup(sink);
+	}
+      return;
+    }
+
+  for (int r = 0; r < rows; r++)
+    {
+      for (size_t c = 0; c < columns; c++)
+	{
+	  char number[32];
+	  double value = values[r * columns + c];
+	  int length = (sink.types[c] == 'i') ? snprintf(number, sizeof(number), "%lld", (long long)value)
+					       : snprintf(number, sizeof(number), "%g", value);
+
+	  sink.text.insert(sink.text.end(), number, number + length);
+	  if (c + 1 < columns)
+	    {
+	      sink.text.push_back(',');
+	      sink.text.push_back(' ');
+	    }
+	}
+      sink.text.push_back('\n');
+    }
+  if (sink.text.size() >= SINK_BUFFER_BYTES)
+    {
+      fwrite(sink.text.data(), 1, sink.text.size(), sink.file);
+      sink.text.clear();
+    }
+}
+
+/***************************************************************************
+ * bool closeSink(resultsSink &)
+ * Date: 17 October 2026
+ * Description: writes out whatever is still buffered (and the footer of a
+ *columnar file) and closes the file.
+ *
+ * Parameters:
+ * sink I/O resultsSink&  sink to be closed
+ * closeSink O/P bool  false if anything could not be written
+ **************************************************************************/
+bool closeSink(resultsSink &sink)
+{
+  if (sink.file == NULL)
+    return !sink.failed;
+
+  if (sink.columnar)
+    {
+      vector<char> footer;
+      auto put = [&footer](const void *data, size_t bytes) {
+	footer.insert(footer.end(), (const char *)data, (const char *)data + bytes);
+      };
+      uint32_t columns = sink.names.size(), groups;
+
+      flushSinkGroup(sink);
+      groups = sink.groupRows.size();
+      put(&columns, 4);
+      for (size_t c = 0; c < columns; c++)
+	{
+	  uint32_t length = sink.names[c].size();
+
+	  put(&sink.types[c], 1);
+	  put(&length, 4);
+	  put(sink.names[c].data(), length);
+	}
+      put(&groups, 4);
+      for (size_t g = 0; g < groups; g++)
+	{
+	  put(&sink.groupRows[g], 8);
+	  put(&sink.groupOffsets[g], 8);
+	}
+      uint32_t length = footer.size();
+      put(&length, 4);
+      put(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC));
+      fwrite(footer.data(), 1, footer.size(), sink.file);
+    }
+  else
+    fwrite(sink.text.data(), 1, sink.text.size(), sink.file);
+
+  sink.failed |= (ferror(sink.file) != 0);
+  sink.failed |= (fclose(sink.file) != 0);
+  sink.file = NULL;
+  if (sink.failed)
+    cerr << "could not write results\n";
+  return !sink.failed;
+}
+
+/***************************************************************************
+ * int readResults(const char *)
+ * Date: 17 October 2026
+ * Description: prints a columnar results file as comma separated text
+ *(--read-results), doubles with every digit. Reads the footer first and
+ *then one row group at a time.
+ *
+ * Parameters:
+ * path I/P const char*  columnar file to be read
+ * readResults O/P int  status code, 1 if the file could not be read
+ **************************************************************************/
+int readResults(const char *path)
+{
+  FILE *file = fopen(path, "rb");
+  char magic[sizeof(COLUMNAR_MAGIC)];
+  uint32_t footerLength = 0;
+  long size;
+
+  if (file == NULL || fread(magic, 1, sizeof(magic), file) != sizeof(magic) || memcmp(magic, COLUMNAR_MAGIC, sizeof(magic)) != 0 ||
+      fseek(file, -(long)(4 + sizeof(magic)), SEEK_END) != 0 || fread(&footerLength, 4, 1, file) != 1 ||
+      (size = ftell(file)) < 0 || footerLength > (uint64_t)size - 4 - sizeof(magic))
+    {
+      cerr << "not a columnar results file: " << path << "\n";
+      if (file != NULL)
+	fclose(file);
+      return 1;
+    }
+
+  vector<char> footer(footerLength);
+  const char *at = footer.data();
+  auto get = [&at](void *data, size_t bytes) {
+    memcpy(data, at, bytes);
+    at += bytes;
+  };
+  uint32_t columns, groups;
+  string types;
+
+  fseek(file, size - 4 - footerLength, SEEK_SET);
+  if (fread(footer.data(), 1, footerLength, file) != footerLength)
+    footer.assign(footerLength, 0);
+  get(&columns, 4);
+  for (uint32_t c = 0; c < columns; c++)
+    {
+      char type;
+      uint32_t length;
+
+      get(&type, 1);
+      get(&length, 4);
+      types.push_back(type);
+      cout << string(at, length) << (c + 1 < columns ? ", " : "\n");
+      at += length;
+    }
+  get(&groups, 4);
+
+  for (uint32_t g = 0; g < groups; g++)
+    {
+      uint64_t rows, offset;
+      vector<uint64_t> chunk;
+
+      get(&rows, 8);
+      get(&offset, 8);
+      chunk.resize(rows * columns);
+      fseek(file, offset, SEEK_SET);
+      if (fread(chunk.data(), 8, chunk.size(), file) != chunk.size())
+	{
+	  cerr << "truncated columnar results file: " << path << "\n";
+	  fclose(file);
+	  return 1;
+	}
+      for (uint64_t r = 0; r < rows; r++)
+	{
+	  for (uint32_t c = 0; c < columns; c++)
+	    {
+	      char number[32];
+	      uint64_t bits = chunk[c * rows + r];
+
+	      if (types[c] == 'i')
+		{
+		  int64_t whole;
+		  memcpy(&whole, &bits, 8);
+		  snprintf(number, sizeof(number), "%lld", (long long)whole);
+		}
+	      else
+		{
+		  double value;
+		  memcpy(&value, &bits, 8);
+		  snprintf(number, sizeof(number), "%.17g", value);
+		}
+	      cout << number << (c + 1 < columns ? ", " : "\n");
+	    }
+	}
+    }
+  fclose(file);
+  return 0;
+}
+
+/***************************************************************************
+ * bool finishDiskModel(diskModel &)
+ * Date: 17 October 2026
+ * Description: checks the parameters of a disk model and works out its per
+ *track tables (sectors and time per sector of every track) and the
+ *address of the first sector of every zone.
+ *
+ * Parameters:
+ * disk I/O diskModel&  model to be checked and finished
+ * finishDiskModel O/P bool  false, with a message on cerr, if the model is not usable
+ **************************************************************************/
+bool finishDiskModel(diskModel &disk)
+{
+  const char *problem = NULL;
+
+  if (disk.tracks < 2 || disk.tracks > MAX_GEOMETRY)
+    problem = "tracks must be 2-65536";
+  else if (disk.startTrack < 0 || disk.startTrack >= disk.tracks)
+    problem = "start_track must be one of the tracks";
+  else if (!(disk.rotationMs > 0) || disk.trackMs < 0 || disk.settleMs < 0 || disk.accelMs < 0 || disk.accelTracks < 0 ||
+	   disk.snapbackMs < 0)
+    problem = "times must not be negative and rotation_ms must be over 0";
+  else if (disk.zones < 1 || disk.zoneFirst[0] != 0)
+    problem = "the first zone must start at track 0";
+
+  for (int zone = 0; zone < disk.zones && problem == NULL; zone++)
+    {
+      if (disk.zoneSectors[zone] < 1 || disk.zoneSectors[zone] > MAX_GEOMETRY)
+	problem = "zones must have 1-65536 sectors per track";
+      else if (zone > 0 && (disk.zoneFirst[zone] <= disk.zoneFirst[zone - 1] || disk.zoneFirst[zone] >= disk.tracks))
+	problem = "zones must start on increasing tracks of the disk";
+    }
+  if (problem != NULL)
+    {
+      cerr << "disk model: " << problem << "\n";
+      return false;
+    }
+
+  disk.sectorCount.resize(disk.tracks);
+  disk.sectorMs.resize(disk.tracks);
+  disk.zoneAddress[0] = 0;
+  for (int zone = 0; zone < disk.zones; zone++)
+    {
+      int last = (zone + 1 < disk.zones) ? disk.zoneFirst[zone + 1] : disk.tracks;
+
+      for (int track = disk.zoneFirst[zone]; track < last; track++)
+	{
+	  disk.sectorCount[track] = disk.zoneSectors[zone];
+	  disk.sectorMs[track] = disk.rotationMs / disk.zoneSectors[zone];
+	}
+      disk.zoneAddress[zone + 1] = disk.zoneAddress[zone] + (uint64_t)(last - disk.zoneFirst[zone]) * disk.zoneSectors[zone];
+    }
+  disk.addresses = disk.zoneAddress[disk.zones];
+  if (disk.addresses >= INT_MAX) // the generators draw addresses as ints
+    {
+      cerr << "disk model: the disk must have under 2^31 sectors\n";
+      return false;
+    }
+  return true;
+}
+
+/***************************************************************************
+ * void classicModel(diskModel &)
+ * Date: 17 October 2026
+ * Description: sets a disk model to classicDisk, run with the compile time
+ *kernels. It is also the starting point of a disk model file, so a file
+ *only has to give what is different.
+ *
+ * Parameters:
+ * disk O/P diskModel&  model to be set
+ **************************************************************************/
+void classicModel(diskModel &disk)
+{
+  disk.compiled = true;
+  disk.tracks = classicDisk::tracks;
+  disk.startTrack = classicDisk::startTrack;
+  disk.rotationMs = classicDisk::sectors * classicDisk::sectorMs;
+  disk.trackMs = classicDisk::trackMs;
+  disk.settleMs = 0;
+  disk.accelMs = 0;
+  disk.accelTracks = 0;
+  disk.snapbackMs = classicDisk::snapbackMs;
+  disk.zones = 1;
+  disk.zoneFirst[0] = 0;
+  disk.zoneSectors[0] = classicDisk::sectors;
+  finishDiskModel(disk);
+}
+
+/***************************************************************************
+ * bool loadDiskModel(const char *, diskModel &)
+ * Date: 17 October 2026
+ * Description: reads a disk model file (--disk). Every line is a name and
+ *value(s), anything after # is a comment:
+ *  tracks N, start_track N, rotation_ms T, track_ms T, settle_ms T,
+ *  accel_ms T, accel_tracks N, snapback_ms T, sectors N (every track),
+ *  zone FIRST_TRACK SECTORS (one line per zone, in track order).
+ *Anything not given keeps its classicDisk value. A model read from a file
+ *always runs on the run time kernels, even if it matches classicDisk.
+ *
+ * Parameters:
+ * path I/P const char*  file to be read, or "classic"
+ * disk O/P diskModel&  model read
+ * loadDiskModel O/P bool  false, with a message on cerr, if the file could not be used
+ **************************************************************************/
+bool loadDiskModel(const char *path, diskModel &disk)
+{
+  FILE *file;
+  char line[256];
+  int number = 0;
+  bool zoned = false; // a zone line has been read, replacing the classic zone
+
+  classicModel(disk);
+  if (strcmp(path, "classic") == 0)
+    return true;
+  if ((file = fopen(path, "r")) == NULL)
+    {
+      cerr << "could not open disk model " << path << "\n";
+      return false;
+    }
+
+  disk.compiled = false;
+  while (fgets(line, sizeof(line), file) != NULL)
+    {
+      char name[32];
+      double value, second = 0;
+      int fields;
+
+      number++;
+      line[strcspn(line, "#")] = '\0';
+      fields = sscanf(line, "%31s %lf %lf", name, &value, &second);
+      if (fields <= 0)
+	continue; // blank or comment
+
+      bool known = (fields >= 2);
+      if (!known)
+	;
+      else if (strcmp(name, "tracks") == 0)
+	disk.tracks = (int)value;
+      else if (strcmp(name, "start_track") == 0)
+	disk.startTrack = (int)value;
+      else if (strcmp(name, "rotation_ms") == 0)
+	disk.rotationMs = value;
+      else if (strcmp(name, "track_ms") == 0)
+	disk.trackMs = value;
+      else if (strcmp(name, "settle_ms") == 0)
+	disk.settleMs = value;
+      else if (strcmp(name, "accel_ms") == 0)
+	disk.accelMs = value;
+      else if (strcmp(name, "accel_tracks") == 0)
+	disk.accelTracks = (int)value;
+      else if (strcmp(name, "snapback_ms") == 0)
+	disk.snapbackMs = value;
+      else if (strcmp(name, "sectors") == 0 && !zoned)
+	disk.zoneSectors[0] = (int)value;
+      else if (strcmp(name, "zone") == 0 && fields == 3 && (!zoned || disk.zones < MAX_ZONES))
+	{
+	  int zone = zoned ? disk.zones++ : 0;
+
+	  disk.zoneFirst[zone] = (int)value;
+	  disk.zoneSectors[zone] = (int)second;
+	  zoned = true;
+	}
+      else
+	known = false;
+
+      if (!known)
+	{
+	  cerr << path << ":" << number << ": not understood: " << name << "\n";
+	  fclose(file);
+	  return false;
+	}
+    }
+  fclose(file);
+  return finishDiskModel(disk);
+}
+
+/***************************************************************************
+ * point addressPoint(uint64_t)
+ * Date: 17 October 2026
+ * Description: point of the disk at an address, numbering the sectors of
+ *the disk track by track from track 0, sector 0.
+ *
+ * Parameters:
+ * address I/P uint64_t  address, below activeDisk.addresses
+ * addressPoint O/P point  the point at the address
+ **************************************************************************/
+inline point addressPoint(uint64_t address)
+{
+  int zone = 0;
+  point result;
+
+  if (activeDisk.compiled) // every track the same, divided by a constant
+    {
+      result.track = (double)(address / classicDisk::sectors);
+      result.sector = (double)(address % classicDisk::sectors);
+      result.accessed = false;
+      return result;
+    }
+  while (zone + 1 < activeDisk.zones && address >= activeDisk.zoneAddress[zone + 1])
+    {
+      zone++;
+    }
+  address -= activeDisk.zoneAddress[zone];
+
+  result.track = (double)(activeDisk.zoneFirst[zone] + address / activeDisk.zoneSectors[zone]);
+  result.sector = (double)(address % activeDisk.zoneSectors[zone]);
+  result.accessed = false;
+  return result;
+}
+
+/***************************************************************************
+ * point randomPoint(rngStream &)
+ * Date: 17 October 2026
+ * Description: random point with a uniform track and a uniform sector of
+ *that track (duplicates allowed), for the arrival processes and the
+ *benchmarks.
+ *
+ * Parameters:
+ * rng I/O rngStream&  random stream the point is drawn from
+ * randomPoint O/P point  the point
+ **************************************************************************/
+point randomPoint(rngStream &rng)
+{
+  point result;
+
+  result.track = uniform(rng, 0, activeDisk.tracks - 1);
+  result.sector = uniform(rng, 0, activeDisk.sectorCount[(int)result.track] - 1);
+  result.accessed = false;
+  return result;
+}
+
+/***************************************************************************
+ * double checkSector(double, double)
+ * Author: Logan Wheat
+ * Date: 16 November 2019
+ * Description: simulates disk completing a rotation by ensuring sector 
+ *stays in the range of 0-12000 (0-sectors on the track).
+ *
+ * Parameters:
+ * sector I/O double  sector passed to ensure stays within range, returned to function
+ * sectors I/P double  sectors in one rotation of the track
+ **************************************************************************/
+double checkSector(double sector, double sectors = classicDisk::sectors)
+{
+  if (sector < sectors)
+    {
+      return (sector + sectors);
+    }
+  else if (sector > sectors)
+    {
+      return (sector - sectors);
+    }
+  return sector;
+}
+
+/***************************************************************************
+ * double arrivalSector(const Disk &, double, double, double)
+ * Date: 17 October 2026
+ * Description: sector of the requested track the head is over when it gets
+ *there: the sector it was on (measured in the requested track's sectors)
+ *plus the sectors that went by during the seek, kept in range by
+ *checkSector(). Disk is classicDisk or diskModel.
+ *
+ * Parameters:
+ * disk I/P const Disk&  disk model
+ * currentTrack I/P double  track the head is on
+ * currentSector I/P double  sector the head is on
+ * track I/P double  requested track
+ * arrivalSector O/P double  sector the head arrives over
+ **************************************************************************/
+template <class Disk>
+inline double arrivalSector(const Disk &disk, double currentTrack, double currentSector, double track)
+{
+  double trackDistance = abs(currentTrack - track);
+
+  // hdd is spinning counter clockwise
+  currentSector = disk.sectorOn(currentSector, currentTrack, track);
+  currentSector += (disk.seekTime(trackDistance) / disk.sectorTime(track)); // calculate current sector as 1 sector is passed every sectorTime
+  return checkSector(currentSector, disk.sectorsOn(track)); // call to function that makes sure sector is in range
+}
+
+/***************************************************************************
+ * void stepCostModel(const Disk &, double, double, double, double, double &, double &)
+ * Date: 17 October 2026
+ * Description: cost model shared by every scheduler, for any disk model.
+ *Works out the time to move the head from the current point to the
+ *requested one: the seek (the seek curve, or the snapback if that is
+ *faster) and the rotational latency (sectors passed times the time per
+ *sector of the requested track). After the step the head is on the
+ *requested track and sector. With classicDisk this is exactly the
+ *original arithmetic, with the constants folded in.
+ *
+ * Parameters:
+ * disk I/P const Disk&  disk model
+ * currentTrack I/P double  track the head is on
+ * currentSector I/P double  sector the head is on
+ * track I/P double  requested track
+ * sector I/P double  requested sector
+ * seek O/P double&  seek time in milliseconds
+ * rotation O/P double&  rotational latency in milliseconds
+ **************************************************************************/
+template <class Disk>
+inline void stepCostModel(const Disk &disk, double currentTrack, double currentSector, double track, double sector,
+			  double &seek, double &rotation)
+{
+  double travel = disk.seekTime(abs(currentTrack - track)); // seek straight to the requested track
+  double snapback = disk.snapbackMs + disk.seekTime(track); // snap back to track 0 and seek out from there
+  double sectors = disk.sectorsOn(track); // sectors in one rotation of the requested track
+  double perSector = disk.sectorTime(track); // time for one of them to pass under the head
+
+  // determine if snapback feature should be used
+  if (travel < snapback) // if snapback is not faster (slower)
+    {
+      seek = travel;
+    }
+  else // if snapback is faster
+    {
+      seek = snapback;
+    }
+
+  currentSector = arrivalSector(disk, currentTrack, currentSector, track);
+
+  if (currentSector > sector) // if requested sector is before current sector and requires another rotation
+    {
+      rotation = abs(((sectors - (currentSector - sector)) * perSector)); // add the time of every sector crossed
+    }
+  else // if requested sector is further on the track or in the correct spot
+    {
+      rotation = abs(((currentSector - sector) * perSector)); // add the time of every sector crossed
+    }
+}
+
+/***************************************************************************
+ * double seekTime(double)
+ * Date: 17 October 2026
+ * Description: seek time over a distance on the disk being simulated,
+ *without the snapback. satf uses it to rule tracks out before working out
+ *a whole step.
+ *
+ * Parameters:
+ * distance I/P double  tracks crossed
+ * seekTime O/P double  seek time in milliseconds
+ **************************************************************************/
+double runtimeSeekTime(double distance)
+{
+  return activeDisk.seekTime(distance);
+}
+
+inline double seekTime(double distance)
+{
+  if (activeDisk.compiled)
+    return classicDisk::seekTime(distance);
+  return runtimeSeekTime(distance);
+}
+
+/***************************************************************************
+ * void stepCost(double, double, double, double, double &, double &)
+ * Date: 17 October 2026
+ * Description: cost model shared by every scheduler. Works out the seek
+ *time and rotational latency of one step on the disk being simulated
+ *(see stepCostModel), using the compile time kernel when that is the
+ *classic disk and runtimeStepCost otherwise.
+ *
+ * Parameters:
+ * currentTrack I/P double  track the head is on
+ * currentSector I/P double  sector the head is on
+ * track I/P double  requested track
+ * sector I/P double  requested sector
+ * seek O/P double&  seek time in milliseconds
+ * rotation O/P double&  rotational latency in milliseconds
+ **************************************************************************/
+void runtimeStepCost(double currentTrack, double currentSector, double track, double sector, double &seek, double &rotation)
+{
+  stepCostModel(activeDisk, currentTrack, currentSector, track, sector, seek, rotation);
+}
+
+inline void stepCost(double currentTrack, double currentSector, double track, double sector, double &seek, double &rotation)
+{
+  // the run time model is called out of line so this stays small enough to inline into the schedulers
+  if (activeDisk.compiled)
+    stepCostModel(classicDisk(), currentTrack, currentSector, track, sector, seek, rotation);
+  else
+    runtimeStepCost(currentTrack, currentSector, track, sector, seek, rotation);
+}
+
+/***************************************************************************
+ * void serviceStep(double &, double &, double, double, double &, double *)
+ * Date: 17 October 2026
+ * Description: moves the head to the requested point, adding the time it
+ *took to totalTime. Used when the next point depends on where the head is
+ *(sstf), otherwise stepCosts() works out a whole path at once.
+ *
+ * Parameters:
+ * currentTrack I/O double&  track the head is on, set to the requested track
+ * currentSector I/O double&  sector the head is on, set to the requested sector
+ * track I/P double  requested track
+ * sector I/P double  requested sector
+ * totalTime I/O double&  running total time in milliseconds
+ * stepTime O/P double*  set to the time of the step, if not NULL
+ **************************************************************************/
+inline void serviceStep(double &currentTrack, double &currentSector, double track, double sector, double &totalTime,
+			double *stepTime = NULL)
+{
+  double seek, rotation;
+
+  stepCost(currentTrack, currentSector, track, sector, seek, rotation);
+  totalTime += seek;
+  totalTime += rotation;
+  if (stepTime != NULL)
+    *stepTime = seek + rotation;
+
+  currentTrack = track; // set current track as the requested track
+  currentSector = sector; // set current sector to current request
+}
+
+/***************************************************************************
+ * void stepCostsScalar(const double[], const double[], int, double[], double[])
+ * Date: 17 October 2026
+ * Description: works out the seek time and rotational latency of every step
+ *of a path that is already known. Step i only depends on point i - 1 (the
+ *head starts at the start track, sector 0), so the steps are independent of
+ *each other.
+ *
+ * Parameters:
+ * track I/P const double[]  requested tracks in the order they are serviced
+ * sector I/P const double[]  requested sectors in the order they are serviced
+ * n I/P int  number of points in the path
+ * seek O/P double[]  seek time of each step
+ * rotation O/P double[]  rotational latency of each step
+ **************************************************************************/
+void stepCostsScalar(const double track[], const double sector[], int n, double seek[], double rotation[])
+{
+  auto steps = [&](const auto &disk) {
+    for (int i = 0; i < n; i++)
+      {
+	stepCostModel(disk, i == 0 ? activeDisk.startTrack : track[i - 1], i == 0 ? 0 : sector[i - 1], track[i], sector[i],
+		      seek[i], rotation[i]);
+      }
+  };
+
+  // pick the kernel once for the whole path
+  if (activeDisk.compiled)
+    steps(classicDisk());
+  else
+    steps(activeDisk);
+}
+
+#ifdef __AVX2__
+/***************************************************************************
+ * void stepCostsAvx2(const double[], const double[], int, double[], double[])
+ * Date: 17 October 2026
+ * Description: AVX2 version of stepCostsScalar, four steps at a time with
+ *the branches of stepCost() turned into blends. Uses exactly the same
+ *operations in the same order, so the results are bit for bit the same.
+ *
+ * Parameters:
+ * track I/P const double[]  requested tracks in the order they are serviced
+ * sector I/P const double[]  requested sectors in the order they are serviced
+ * n I/P int  number of points in the path
+ * seek O/P double[]  seek time of each step
+ * rotation O/P double[]  rotational latency of each step
+ **************************************************************************/
+void stepCostsAvx2(const double track[], const double sector[], int n, double seek[], double rotation[])
+{
+  const __m256d signBit = _mm256_set1_pd(-0.0);
+  const __m256d perTrack = _mm256_set1_pd(classicDisk::trackMs);
+  const __m256d perSector = _mm256_set1_pd(classicDisk::sectorMs);
+  const __m256d snapback = _mm256_set1_pd(classicDisk::snapbackMs);
+  const __m256d rotationSectors = _mm256_set1_pd(classicDisk::sectors);
+  int i = 1;
+
+  if (n <= 0)
+    return;
+  stepCostsScalar(track, sector, 1, seek, rotation); // first step starts from the middle track
+
+  for (; i + 4 <= n; i += 4)
+    {
+      __m256d currentTrack = _mm256_loadu_pd(track + i - 1);
+      __m256d currentSector = _mm256_loadu_pd(sector + i - 1);
+      __m256d nextTrack = _mm256_loadu_pd(track + i);
+      __m256d nextSector = _mm256_loadu_pd(sector + i);
+
+      __m256d distance = _mm256_andnot_pd(signBit, _mm256_sub_pd(currentTrack, nextTrack));
+      __m256d travel = _mm256_mul_pd(distance, perTrack);
+      __m256d snap = _mm256_add_pd(snapback, _mm256_mul_pd(nextTrack, perTrack));
+      _mm256_storeu_pd(seek + i, _mm256_blendv_pd(snap, travel, _mm256_cmp_pd(travel, snap, _CMP_LT_OQ)));
+
+      // checkSector()
+      __m256d s = _mm256_add_pd(currentSector, _mm256_div_pd(travel, perSector));
+      __m256d wrapped = _mm256_blendv_pd(s, _mm256_sub_pd(s, rotationSectors), _mm256_cmp_pd(s, rotationSectors, _CMP_GT_OQ));
+      s = _mm256_blendv_pd(wrapped, _mm256_add_pd(s, rotationSectors), _mm256_cmp_pd(s, rotationSectors, _CMP_LT_OQ));
+
+      __m256d gap = _mm256_sub_pd(s, nextSector);
+      __m256d behind = _mm256_mul_pd(_mm256_sub_pd(rotationSectors, gap), perSector);
+      __m256d ahead = _mm256_mul_pd(gap, perSector);
+      __m256d latency = _mm256_blendv_pd(ahead, behind, _mm256_cmp_pd(s, nextSector, _CMP_GT_OQ));
+      _mm256_storeu_pd(rotation + i, _mm256_andnot_pd(signBit, latency));
+    }
+
+  for (; i < n; i++)
+    {
+      stepCost(track[i - 1], sector[i - 1], track[i], sector[i], seek[i], rotation[i]);
+    }
+}
+#endif
+
+#ifdef __AVX512F__
+/***************************************************************************
+ * void stepCostsAvx512(const double[], const double[], int, double[], double[])
+ * Date: 17 October 2026
+ * Description: AVX-512 version of stepCostsScalar, eight steps at a time
+ *using mask registers for the branches of stepCost(). Bit for bit the same
+ *as the scalar version.
+ *
+ * Parameters:
+ * track I/P const double[]  requested tracks in the order they are serviced
+ * sector I/P const double[]  requested sectors in the order they are serviced
+ * n I/P int  number of points in the path
+ * seek O/P double[]  seek time of each step
+ * rotation O/P double[]  rotational latency of each step
+ **************************************************************************/
+void stepCostsAvx512(const double track[], const double sector[], int n, double seek[], double rotation[])
+{
+  const __m512d perTrack = _mm512_set1_pd(classicDisk::trackMs);
+  const __m512d perSector = _mm512_set1_pd(classicDisk::sectorMs);
+  const __m512d snapback = _mm512_set1_pd(classicDisk::snapbackMs);
+  const __m512d rotationSectors = _mm512_set1_pd(classicDisk::sectors);
+  int i = 1;
+
+  if (n <= 0)
+    return;
+  stepCostsScalar(track, sector, 1, seek, rotation); // first step starts from the middle track
+
+  for (; i + 8 <= n; i += 8)
+    {
+      __m512d currentTrack = _mm512_loadu_pd(track + i - 1);
+      __m512d currentSector = _mm512_loadu_pd(sector + i - 1);
+      __m512d nextTrack = _mm512_loadu_pd(track + i);
+      __m512d nextSector = _mm512_loadu_pd(sector + i);
+
+      __m512d distance = _mm512_abs_pd(_mm512_sub_pd(currentTrack, nextTrack));
+      __m512d travel = _mm512_mul_pd(distance, perTrack);
+      __m512d snap = _mm512_add_pd(snapback, _mm512_mul_pd(nextTrack, perTrack));
+      _mm512_storeu_pd(seek + i, _mm512_mask_blend_pd(_mm512_cmp_pd_mask(travel, snap, _CMP_LT_OQ), snap, travel));
+
+      // checkSector()
+      __m512d s = _mm512_add_pd(currentSector, _mm512_div_pd(travel, perSector));
+      __m512d wrapped = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(s, rotationSectors, _CMP_GT_OQ), s, _mm512_sub_pd(s, rotationSectors));
+      s = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(s, rotationSectors, _CMP_LT_OQ), wrapped, _mm512_add_pd(s, rotationSectors));
+
+      __m512d gap = _mm512_sub_pd(s, nextSector);
+      __m512d behind = _mm512_mul_pd(_mm512_sub_pd(rotationSectors, gap), perSector);
+      __m512d ahead = _mm512_mul_pd(gap, perSector);
+      __m512d latency = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(s, nextSector, _CMP_GT_OQ), ahead, behind);
+      _mm512_storeu_pd(rotation + i, _mm512_abs_pd(latency));
+    }
+
+  for (; i < n; i++)
+    {
+      stepCost(track[i - 1], sector[i - 1], track[i], sector[i], seek[i], rotation[i]);
+    }
+}
+#endif
+
+/***************************************************************************
+ * void stepCosts(const double[], const double[], int, double[], double[])
+ * Date: 17 October 2026
+ * Description: works out the cost of every step of a known path with the
+ *widest vector instructions the program was compiled for (-mavx512f,
+ *-mavx2 or -march=native), falling back to stepCostsScalar.
+ *
+ * Parameters:
+ * track I/P const double[]  requested tracks in the order they are serviced
+ * sector I/P const double[]  requested sectors in the order they are serviced
+ * n I/P int  number of points in the path
+ * seek O/P double[]  seek time of each step
+ * rotation O/P double[]  rotational latency of each step
+ **************************************************************************/
+void stepCosts(const double track[], const double sector[], int n, double seek[], double rotation[])
+{
+  if (!activeDisk.compiled) // the vector versions are only written for the classic disk
+    {
+      stepCostsScalar(track, sector, n, seek, rotation);
+      return;
+    }
+#if defined(__AVX512F__)
+  stepCostsAvx512(track, sector, n, seek, rotation);
+#elif defined(__AVX2__)
+  stepCostsAvx2(track, sector, n, seek, rotation);
+#else
+  stepCostsScalar(track, sector, n, seek, rotation);
+#endif
+}
+
+/***************************************************************************
+ * double pathTime(const double[], const double[], int, latencyHistogram *, const uint8_t[], double[], double[])
+ * double pathTime(schedulePath &, latencyHistogram *)
+ * Date: 17 October 2026
+ * Description: total time to service a known path, starting from track
+ *2499, sector 0. The step costs are worked out in one batch and then added
+ *up in order, so the total is the same as servicing the points one at a
+ *time with serviceStep(). Points marked in edge are stops at the end of
+ *the disk rather than requests (see addEdgeStop); their time is added to
+ *the service time of the request after them.
+ *
+ * Parameters:
+ * track I/P const double[]  requested tracks in the order they are serviced
+ * sector I/P const double[]  requested sectors in the order they are serviced
+ * n I/P int  number of points in the path
+ * histogram I/O latencyHistogram*  records the time of every request, if not NULL
+ * edge I/P const uint8_t[]  1 for the points that are edge stops, NULL if there are none
+ * seek O/P double[]  scratch of at least n, seek time of every point
+ * rotation O/P double[]  scratch of at least n, rotational latency of every point
+ * path I/O schedulePath&  path holding all of the above
+ * pathTime O/P double  total time in milliseconds
+ **************************************************************************/
+double pathTime(const double track[], const double sector[], int n, latencyHistogram *histogram, const uint8_t edge[],
+		double seek[], double rotation[])
+{
+  double totalTime = 0;
+
+  stepCosts(track, sector, n, seek, rotation);
+  for (int i = 0; i < n; i++)
+    {
+      totalTime += seek[i];
+      totalTime += rotation[i];
+    }
+
+  // service time of every request, in a separate loop so the sum above stays tight
+  if (histogram != NULL)
+    {
+      int requests = 0;
+      double carry = 0; // time spent on edge stops since the last request
+
+      for (int i = 0; i < n; i++)
+	{
+	  double step = seek[i] + rotation[i];
+
+	  if (edge != NULL && edge[i])
+	    carry += step;
+	  else
+	    {
+	      seek[requests++] = carry + step;
+	      carry = 0;
+	    }
+	}
+      recordPath(*histogram, seek, requests, totalTime);
+    }
+  return totalTime;
+}
+
+double pathTime(schedulePath &path, latencyHistogram *histogram)
+{
+  return pathTime(path.track, path.sector, path.stops, histogram, path.edge, path.seek, path.rotation);
+}
+
+/***************************************************************************
+ * double edgeSector(double, double, double)
+ * Date: 17 October 2026
+ * Description: sector to give a stop at the first or last track, for the
+ *schedulers that carry on to the end of the disk before turning around.
+ *Nothing is requested there, so it is the sector the head arrives over
+ *(worked out the same way stepCost() does), which makes the stop's
+ *rotational latency 0 and its time just the seek.
+ *
+ * Parameters:
+ * currentTrack I/P double  track the head is on
+ * currentSector I/P double  sector the head is on
+ * edgeTrack I/P double  track of the stop, 0 or the last track
+ * edgeSector O/P double  sector of the stop
+ **************************************************************************/
+double edgeSector(double currentTrack, double currentSector, double edgeTrack)
+{
+  if (activeDisk.compiled)
+    return arrivalSector(classicDisk(), currentTrack, currentSector, edgeTrack);
+  return arrivalSector(activeDisk, currentTrack, currentSector, edgeTrack);
+}
+
+/***************************************************************************
+ * void addStop(schedulePath &, double, double)
+ * void addEdgeStop(schedulePath &, double)
+ * Date: 17 October 2026
+ * Description: add a requested point, or a stop at the first or last track
+ *(see edgeSector), to the end of a schedulePath.
+ *
+ * Parameters:
+ * path I/O schedulePath&  path the stop is added to
+ * track I/P double  track of the requested point
+ * sector I/P double  sector of the requested point
+ * edgeTrack I/P double  track to stop at, 0 or the last track
+ **************************************************************************/
+inline void addStop(schedulePath &path, double track, double sector)
+{
+  path.track[path.stops] = track;
+  path.sector[path.stops] = sector;
+  path.edge[path.stops] = 0;
+  path.stops++;
+}
+
+void addEdgeStop(schedulePath &path, double edgeTrack)
+{
+  double currentTrack = (path.stops == 0) ? activeDisk.startTrack : path.track[path.stops - 1];
+  double currentSector = (path.stops == 0) ? 0 : path.sector[path.stops - 1];
+
+  path.sector[path.stops] = edgeSector(currentTrack, currentSector, edgeTrack);
+  path.track[path.stops] = edgeTrack;
+  path.edge[path.stops] = 1;
+  path.stops++;
+}
+
+/***************************************************************************
+ * double fifo(const requestQueue &, int, latencyHistogram *, pathScratch &)
+ * Author: Logan Wheat
+ * Date: 15 November 2019
+ * Description: simulates a first in first out disk scheduling algorithm.
+ *Calculates the total time spent seeking and then returns
+ *(total time / request size) to calculate average seek time between
+ *requests in milliseconds. Every scheduler takes the same parameters
+ *(see schedulerFunction) so they can be picked from SCHEDULERS.
+ *
+ * Parameters:
+ * request I/P const requestQueue&  queue of points that will be accessed in fifo algorithm
+ * batch I/P int  requests per batch, only used by nstep
+ * histogram I/O latencyHistogram*  records the service time of every request, if not NULL
+ * scratch I/O pathScratch&  worker's scratch the path is built in
+**************************************************************************/
+double fifo(const requestQueue &request, int /*batch*/, latencyHistogram *histogram, pathScratch &scratch)
+{
+  int requestSize = request.size; // number of points in the queue
+  schedulePath path(requestSize, scratch);
+
+  // the path is the request in arrival order
+  for (int i = 0; i < requestSize; i++)
+    {
+      addStop(path, request.track[i], request.sector[i]);
+    }
+
+  // return the average seek time in milliseconds
+  return (pathTime(path, histogram) / requestSize);
+}
+
+/***************************************************************************
+ * double sstfLinear(point[], int)
+ * Author: Logan Wheat
+ * Date: 17 November 2019
+ * Description: simulates a shortest service time first disk scheduling algorithm.
+ *Calculates the total time spent seeking and then returns
+ *(total time / request size) to calculate average seek time between
+ *requests in milliseconds. This is the original O(n^2) linear search
+ *version, kept as the reference sstf() is checked against in benchSstf().
+ *
+ * Parameters:
+ * request I/P point[]  array of points that will be accessed in sstf algorithm
+ * requestSize I/P int  size of array of points, that way function does not exceed bounds
+ **************************************************************************/
+double sstfLinear(point request[], int requestSize)
+{
+  double totalTime = 0; // initialize total time to 0 in milliseconds
+
+  double currentTrack = activeDisk.startTrack; // start in the middle of the track
+  double currentSector = 0; // start at sector 0
+  double trackDistance; // declare track distance as a double
+  int closestTrack = -1; // declare closest track as an int, -1 until one is found
+  double currentClosest; // declare current closest as a double
+
+  // for loop to iterate through all request and simulate sstf
+  for (int i = 0; i < requestSize; i++)
+    {
+      currentClosest = activeDisk.tracks; // define current closest as the furthest possible distance
+
+      // for loop to search through sorted list for closest track
+      for (int n = 0; n < requestSize; n++)
+	{
+	  trackDistance = abs(currentTrack - request[n].track);
+
+	  if (trackDistance < currentClosest && request[n].accessed == false) // if current location is closest and has not been accessed, save as closest
+	    {
+	      currentClosest = trackDistance; // update closest track
+	      closestTrack = n; // save index of closest track
+	    }
+	} // end of linear search
+
+      request[closestTrack].accessed = true; // update that this point has been accessed already
+
+      // move the head to the closest track, adding the time it took
+      serviceStep(currentTrack, currentSector, request[closestTrack].track, request[closestTrack].sector, totalTime);
+    } // end of sstf for loop
+
+  // return average seek time in milliseconds
+  return (totalTime / requestSize);
+}
+
+/***************************************************************************
+ * int linkQueue(const requestQueue &, int[], int[], double, int &, int &)
+ * Date: 17 October 2026
+ * Description: links up the unaccessed points of a sorted queue into the
+ *doubly linked list sstf and satf search, and finds the neighbours of the
+ *head in it.
+ *
+ * Parameters:
+ * request I/P const requestQueue&  sorted queue of points
+ * prev O/P int[]  previous unaccessed index of every unaccessed point, -1 if none
+ * next O/P int[]  next unaccessed index of every unaccessed point, the queue size if none
+ * currentTrack I/P double  track the head is on
+ * left O/P int&  closest unaccessed index below the head, -1 if none
+ * right O/P int&  closest unaccessed index at or above the head, the queue size if none
+ * linkQueue O/P int  number of unaccessed points
+ **************************************************************************/
+inline int linkQueue(const requestQueue &request, int prev[], int next[], double currentTrack, int &left, int &right)
+{
+  int requestSize = request.size; // number of points in the queue
+  int pending = 0; // number of points that have not been accessed
+
+  left = -1;
+  right = requestSize;
+  for (int n = 0, last = -1; n < requestSize; n++)
+    {
+      if (!isServiced(request, n))
+	{
+	  prev[n] = last;
+	  next[n] = requestSize;
+	  if (last >= 0)
+	    next[last] = n;
+	  last = n;
+
+	  if (request.track[n] < currentTrack)
+	    left = n;
+	  else if (right == requestSize)
+	    right = n;
+	  pending++;
+	}
+    }
+  return pending;
+}
+
+/***************************************************************************
+ * int nearestTrack(const requestQueue &, int[], int[], double, int &, int &)
+ * Date: 17 October 2026
+ * Description: one step of sstf's search: picks the closest of the head's
+ *two neighbours in the linked list (see linkQueue), ties to the lowest
+ *index, and unlinks it, so its neighbours become the head's.
+ *
+ * Parameters:
+ * request I/P const requestQueue&  sorted queue of points
+ * prev I/O int[]  previous unaccessed index of every unaccessed point
+ * next I/O int[]  next unaccessed index of every unaccessed point
+ * currentTrack I/P double  track the head is on
+ * left I/O int&  closest unaccessed index below the head
+ * right I/O int&  closest unaccessed index at or above the head
+ * nearestTrack O/P int  index of the point picked
+ **************************************************************************/
+inline int nearestTrack(const requestQueue &request, int prev[], int next[], double currentTrack, int &left, int &right)
+{
+  int requestSize = request.size; // number of points in the queue
+  int closestTrack;
+
+  // walk the left neighbour back to the first index with the same track so ties go to the lowest index
+  if (left >= 0)
+    {
+      while (prev[left] >= 0 && request.track[prev[left]] == request.track[left])
+	left = prev[left];
+    }
+
+  // the left neighbour wins ties since it has the lower index
+  if (left >= 0 && (right >= requestSize || currentTrack - request.track[left] <= request.track[right] - currentTrack))
+    closestTrack = left;
+  else
+    closestTrack = right;
+
+  // unlink the closest track, its neighbours become the new candidates
+  left = prev[closestTrack];
+  right = next[closestTrack];
+  if (left >= 0)
+    next[left] = right;
+  if (right < requestSize)
+    prev[right] = left;
+  return closestTrack;
+}
+
+/***************************************************************************
+ * double sstf(const requestQueue &, int, latencyHistogram *, pathScratch &)
+ * Date: 17 October 2026
+ * Description: simulates a shortest service time first disk scheduling algorithm.
+ *Calculates the total time spent seeking and then returns
+ *(total time / request size) to calculate average seek time between
+ *requests in milliseconds.
+ *Since request is sorted by track, the closest unaccessed track is always
+ *the nearest unaccessed neighbour on the left or the right of the head.
+ *Unaccessed points are kept in a doubly linked list over the sorted array,
+ *so finding and removing the closest track is amortized O(1) instead of a
+ *linear search. Ties are broken the same way as sstfLinear (lowest index
+ *wins), which gives the same service order.
+ *The list is the only record of what has been serviced; request is never
+ *written (points already marked in it are skipped), so every scheduler can
+ *run on the same queue in any order, or at the same time.
+ *
+ * Parameters:
+ * request I/P const requestQueue&  sorted queue of points that will be accessed in sstf algorithm
+ * batch I/P int  not used
+ * histogram I/O latencyHistogram*  records the service time of every request, if not NULL
+ * scratch I/O pathScratch&  worker's scratch for the linked list
+ **************************************************************************/
+double sstf(const requestQueue &request, int /*batch*/, latencyHistogram *histogram, pathScratch &scratch)
+{
+  int requestSize = request.size; // number of points in the queue
+  double totalTime = 0; // initialize total time to 0 in milliseconds
+
+  double currentTrack = activeDisk.startTrack; // start in the middle of the track
+  double currentSector = 0; // start at sector 0
+  int closestTrack; // declare closest track as an int
+  int pending = 0; // number of points that have not been accessed
+
+  reservePath(scratch, requestSize);
+  int *prev = scratch.prev.data(); // previous unaccessed index, -1 if none
+  int *next = scratch.next.data(); // next unaccessed index, requestSize if none
+  int left = -1; // closest unaccessed index below the head
+  int right = requestSize; // closest unaccessed index at or above the head
+
+  pending = linkQueue(request, prev, next, currentTrack, left, right);
+
+  double *stepTime = scratch.seek.data(); // time of every step, for the histogram
+
+  // for loop to iterate through all request and simulate sstf
+  for (int i = 0; i < pending; i++)
+    {
+      closestTrack = nearestTrack(request, prev, next, currentTrack, left, right);
+
+      // move the head to the closest track, adding the time it took
+      serviceStep(currentTrack, currentSector, request.track[closestTrack], request.sector[closestTrack], totalTime,
+		  histogram != NULL ? &stepTime[i] : NULL);
+    } // end of sstf for loop
+
+  if (histogram != NULL)
+    recordPath(*histogram, stepTime, pending, totalTime);
+
+  // return average seek time in milliseconds
+  return (totalTime / requestSize);
+}
+
+/***************************************************************************
+ * bool sstfLane(schedulerLane &)
+ * Date: 17 October 2026
+ * Description: sstf() as a state machine (see schedulerLane). Every step
+ *services one request, the same way and in the same order as sstf(), and
+ *then prefetches the list links and tracks of the head's new neighbours,
+ *which the next step's search reads. The last step records the service
+ *times and works out the average.
+ *
+ * Parameters:
+ * lane I/O schedulerLane&  lane of a sorted queue, started by startLane
+ * sstfLane O/P bool  true while there are requests left to search for
+ **************************************************************************/
+bool sstfLane(schedulerLane &lane)
+{
+  const requestQueue &request = *lane.request;
+  pathScratch &scratch = *lane.scratch;
+
+  switch (lane.stage)
+    {
+    case LANE_START:
+      reservePath(scratch, request.size);
+      lane.currentTrack = activeDisk.startTrack; // start in the middle of the track
+      lane.currentSector = 0; // start at sector 0
+      lane.totalTime = 0;
+      lane.serviced = 0;
+      lane.pending = linkQueue(request, scratch.prev.data(), scratch.next.data(), lane.currentTrack, lane.left,
+			       lane.right);
+      lane.stage = LANE_LOOKUP;
+      break;
+
+    case LANE_LOOKUP:
+      {
+	int closestTrack = nearestTrack(request, scratch.prev.data(), scratch.next.data(), lane.currentTrack, lane.left,
+					lane.right);
+
+	serviceStep(lane.currentTrack, lane.currentSector, request.track[closestTrack], request.sector[closestTrack],
+		    lane.totalTime, lane.histogram != NULL ? &scratch.seek[lane.serviced] : NULL);
+	lane.serviced++;
+      }
+      break;
+
+    case LANE_FINISH:
+      if (lane.histogram != NULL)
+	recordPath(*lane.histogram, scratch.seek.data(), lane.pending, lane.totalTime);
+      lane.average = lane.totalTime / request.size;
+      lane.stage = LANE_DONE;
+      return false;
+
+    case LANE_DONE:
+      return false;
+    }
+
+  if (lane.serviced == lane.pending)
+    {
+      lane.stage = LANE_FINISH;
+      return false;
+    }
+
+  // the next search reads the links and tracks of both neighbours
+  if (lane.left >= 0)
+    {
+      __builtin_prefetch(&scratch.prev[lane.left]);
+      __builtin_prefetch(&request.track[lane.left]);
+    }
+  if (lane.right < request.size)
+    __builtin_prefetch(&request.track[lane.right]);
+  return true;
+}
+
+/***************************************************************************
+ * int firstAtOrAbove(const requestQueue &, double)
+ * Date: 17 October 2026
+ * Description: finds where a sweep starting at track starts in a sorted
+ *queue: the closest point at or above track that has not been accessed.
+ *That is the first unaccessed point at or after the first point at or
+ *above track, which a binary search finds.
+ *
+ * Parameters:
+ * request I/P const requestQueue&  sorted queue of points
+ * track I/P double  track the head is on
+ * firstAtOrAbove O/P int  index of the point, request size if there is none
+ **************************************************************************/
+int firstAtOrAbove(const requestQueue &request, double track)
+{
+  int low = 0, high = request.size; // range the point is still in
+
+  while (low < high)
+    {
+      int middle = low + (high - low) / 2;
+
+      if (request.track[middle] < track)
+	low = middle + 1;
+      else
+	high = middle;
+    }
+  while (low < request.size && isServiced(request, low))
+    low++;
+  return low;
+}
+
+/***************************************************************************
+ * bool searchLane(schedulerLane &)
+ * Date: 17 October 2026
+ * Description: firstAtOrAbove() for the middle of the disk as a state
+ *machine (see schedulerLane). Every step halves the range the start point
+ *is in, the same way firstAtOrAbove() does, and prefetches the middle of
+ *what is left, which the next step compares. Once the search is over
+ *lane.low is the start point and the lane is left at LANE_FINISH for the
+ *scheduler to build its path from.
+ *
+ * Parameters:
+ * lane I/O schedulerLane&  lane of a sorted queue, started by startLane
+ * searchLane O/P bool  true while the search goes on
+ **************************************************************************/
+bool searchLane(schedulerLane &lane)
+{
+  const requestQueue &request = *lane.request;
+
+  if (lane.stage == LANE_START)
+    {
+      lane.low = 0;
+      lane.high = request.size;
+      lane.stage = LANE_LOOKUP;
+    }
+  else
+    {
+      int middle = lane.low + (lane.high - lane.low) / 2;
+
+      if (request.track[middle] < activeDisk.startTrack)
+	lane.low = middle + 1;
+      else
+	lane.high = middle;
+    }
+
+  if (lane.low < lane.high)
+    {
+      __builtin_prefetch(&request.track[lane.low + (lane.high - lane.low) / 2]);
+      return true;
+    }
+  while (lane.low < request.size && isServiced(request, lane.low))
+    lane.low++;
+  lane.stage = LANE_FINISH;
+  return false;
+}
+
+/***************************************************************************
+ * double look(const requestQueue &, int, latencyHistogram *, pathScratch &)
+ * Author: Logan Wheat
+ * Date: 19 November 2019
+ * Description: simulates a look scheduling algorithm, which sweeps up from
+ *the middle of the disk and turns around at the last request instead of
+ *carrying on to the last track (this was called scan before the scheduler
+ *registry, see scan() for the version that goes to the end).
+ *Calculates the total time spent seeking and then returns
+ *(total time / request size) to calculate average seek time between
+ *requests in milliseconds.
+ *
+ * Parameters:
+ * request I/P const requestQueue&  sorted queue of points that will be accessed in look algorithm
+ * batch I/P int  not used
+ * histogram I/O latencyHistogram*  records the service time of every request, if not NULL
+ * scratch I/O pathScratch&  worker's scratch the path is built in
+ **************************************************************************/
+double look(const requestQueue &request, int /*batch*/, latencyHistogram *histogram, pathScratch &scratch)
+{
+  int requestSize = request.size; // number of points in the queue
+  double totalTime = 0; // initialize total time to 0 in milliseconds
+
+  int closestTrack = firstAtOrAbove(request, activeDisk.startTrack); // start in the middle of the track
+  int firstClosest = closestTrack; // store first closest to properly simulate look
+  schedulePath path(requestSize, scratch); // path of the head
+
+  // from the closest index upwards through the request
+  for (int i = closestTrack; i < requestSize; i++)
+    {
+      addStop(path, request.track[i], request.sector[i]);
+    }
+
+  // downwards through the request, simulating the head coming back on a look
+  for (int i = firstClosest - 1; i >= 0; i--)
+    {
+      addStop(path, request.track[i], request.sector[i]);
+    }
+
+  totalTime = pathTime(path, histogram);
+
+  // return average seek time in milliseconds
+  return (totalTime / requestSize);
+}
+
+/***************************************************************************
+ * double clook(const requestQueue &, int, latencyHistogram *, pathScratch &)
+ * Author: Logan Wheat
+ * Date: 19 November 2019
+ * Description: simulates a circular look scheduling algorithm, which only
+ *sweeps up and jumps from the last request back to the lowest one (this
+ *was called cscan before the scheduler registry, see cscan() for the
+ *version that goes to the end).
+ *Calculates the total time spent seeking and then returns
+ *(total time / request size) to calculate average seek time between
+ *requests in milliseconds.
+ *
+ * Parameters:
+ * request I/P const requestQueue&  sorted queue of points that will be accessed in clook algorithm
+ * batch I/P int  not used
+ * histogram I/O latencyHistogram*  records the service time of every request, if not NULL
+ * scratch I/O pathScratch&  worker's scratch the path is built in
+ **************************************************************************/
+double clook(const requestQueue &request, int /*batch*/, latencyHistogram *histogram, pathScratch &scratch)
+{
+  int requestSize = request.size; // number of points in the queue
+  double totalTime = 0; // initialize total time to 0 in milliseconds
+
+  int closestTrack = firstAtOrAbove(request, activeDisk.startTrack); // start in the middle of the track
+  int firstClosest = closestTrack; // store the first track accessed for future use
+  schedulePath path(requestSize, scratch); // path of the head
+
+  // from the closest index upwards through the request
+  for (int i = closestTrack; i < requestSize; i++)
+    {
+      addStop(path, request.track[i], request.sector[i]);
+    }
+
+  // upward from the start of the request, simulating the clook looping
+  for (int i = 0; i < firstClosest; i++)
+    {
+      addStop(path, request.track[i], request.sector[i]);
+    }
+
+  totalTime = pathTime(path, histogram);
+
+  // return average seek time in milliseconds
+  return (totalTime / requestSize);
+}
+
+/***************************************************************************
+ * double scan(const requestQueue &, int, latencyHistogram *, pathScratch &)
+ * double scanFrom(const requestQueue &, int, latencyHistogram *, pathScratch &)
+ * bool scanLane(schedulerLane &)
+ * Date: 17 October 2026
+ * Description: simulates a scan (elevator) scheduling algorithm. Sweeps up
+ *from the middle of the disk, carries on to the last track if there are
+ *requests left below, and comes back down for them. The trip to the last
+ *track counts towards the first request after the turn.
+ *scanFrom() does the sweep once the start point is known, and scanLane()
+ *is scan() as a state machine (see schedulerLane), with searchLane() for
+ *the start point.
+ *Returns the average seek time in milliseconds.
+ *
+ * Parameters:
+ * request I/P const requestQueue&  sorted queue of points that will be accessed in scan algorithm
+ * batch I/P int  not used
+ * firstClosest I/P int  start point, see firstAtOrAbove
+ * histogram I/O latencyHistogram*  records the service time of every request, if not NULL
+ * scratch I/O pathScratch&  worker's scratch the path is built in
+ **************************************************************************/
+double scanFrom(const requestQueue &request, int firstClosest, latencyHistogram *histogram, pathScratch &scratch)
+{
+  int requestSize = request.size; // number of points in the queue
+  schedulePath path(requestSize, scratch); // path of the head
+
+  // from the closest index upwards through the request
+  for (int i = firstClosest; i < requestSize; i++)
+    {
+      addStop(path, request.track[i], request.sector[i]);
+    }
+
+  // on to the last track and back down through the rest of the request
+  if (firstClosest > 0)
+    addEdgeStop(path, activeDisk.tracks - 1);
+  for (int i = firstClosest - 1; i >= 0; i--)
+    {
+      addStop(path, request.track[i], request.sector[i]);
+    }
+
+  return (pathTime(path, histogram) / requestSize);
+}
+
+double scan(const requestQueue &request, int /*batch*/, latencyHistogram *histogram, pathScratch &scratch)
+{
+  // start in the middle of the track
+  return scanFrom(request, firstAtOrAbove(request, activeDisk.startTrack), histogram, scratch);
+}
+
+bool scanLane(schedulerLane &lane)
+{
+  if (lane.stage != LANE_FINISH)
+    return lane.stage != LANE_DONE && searchLane(lane);
+  lane.average = scanFrom(*lane.request, lane.low, lane.histogram, *lane.scratch);
+  lane.stage = LANE_DONE;
+  return false;
+}
+
+/***************************************************************************
+ * double cscan(const requestQueue &, int, latencyHistogram *, pathScratch &)
+ * double cscanFrom(const requestQueue &, int, latencyHistogram *, pathScratch &)
+ * bool cscanLane(schedulerLane &)
+ * Date: 17 October 2026
+ * Description: simulates a circular scan scheduling algorithm. Sweeps up
+ *from the middle of the disk, and if there are requests left below it
+ *carries on to the last track, returns to the first and sweeps up again.
+ *Both trips count towards the first request after the return.
+ *cscanFrom() and cscanLane() split it up the same way as scan.
+ *Returns the average seek time in milliseconds.
+ *
+ * Parameters:
+ * request I/P const requestQueue&  sorted queue of points that will be accessed in cscan algorithm
+ * batch I/P int  not used
+ * firstClosest I/P int  start point, see firstAtOrAbove
+ * histogram I/O latencyHistogram*  records the service time of every request, if not NULL
+ * scratch I/O pathScratch&  worker's scratch the path is built in
+ **************************************************************************/
+double cscanFrom(const requestQueue &request, int firstClosest, latencyHistogram *histogram, pathScratch &scratch)
+{
+  int requestSize = request.size; // number of points in the queue
+  schedulePath path(requestSize, scratch); // path of the head
+
+  // from the closest index upwards through the request
+  for (int i = firstClosest; i < requestSize; i++)
+    {
+      addStop(path, request.track[i], request.sector[i]);
+    }
+
+  // on to the last track, back to the first, and up through the rest of the request
+  if (firstClosest > 0)
+    {
+      addEdgeStop(path, activeDisk.tracks - 1);
+      addEdgeStop(path, 0);
+    }
+  for (int i = 0; i < firstClosest; i++)
+    {
+      addStop(path, request.track[i], request.sector[i]);
+    }
+
+  return (pathTime(path, histogram) / requestSize);
+}
+
+double cscan(const requestQueue &request, int /*batch*/, latencyHistogram *histogram, pathScratch &scratch)
+{
+  // start in the middle of the track
+  return cscanFrom(request, firstAtOrAbove(request, activeDisk.startTrack), histogram, scratch);
+}
+
+bool cscanLane(schedulerLane &lane)
+{
+  if (lane.stage != LANE_FINISH)
+    return lane.stage != LANE_DONE && searchLane(lane);
+  lane.average = cscanFrom(*lane.request, lane.low, lane.histogram, *lane.scratch);
+  lane.stage = LANE_DONE;
+  return false;
+}
+
+/***************************************************************************
+ * double nstep(const requestQueue &, int, latencyHistogram *, pathScratch &)
+ * Date: 17 October 2026
+ * Description: simulates an N-step scan scheduling algorithm. The queue is
+ *taken in arrival order, batch requests at a time, and each batch is
+ *serviced with a scan sweep that carries on from where the head is and
+ *the direction it was moving in. Requests of later batches wait even if
+ *the head passes over them, which is what stops a busy area from starving
+ *the rest of the disk. A batch as large as the queue is the same as scan().
+ *Returns the average seek time in milliseconds.
+ *
+ * Parameters:
+ * request I/P const requestQueue&  queue of points in arrival order
+ * batch I/P int  requests per batch, 0 or less for the whole queue
+ * histogram I/O latencyHistogram*  records the service time of every request, if not NULL
+ * scratch I/O pathScratch&  worker's scratch the path is built in
+ **************************************************************************/
+double nstep(const requestQueue &request, int batch, latencyHistogram *histogram, pathScratch &scratch)
+{
+  int requestSize = request.size; // number of points in the queue
+  double currentTrack = activeDisk.startTrack; // start in the middle of the track
+  bool up = true; // the head starts off sweeping up
+  schedulePath path(requestSize, scratch); // path of the head
+  int *order = scratch.order.data(); // indexes of one batch, sorted by track
+
+  if (batch <= 0 || batch > requestSize)
+    batch = requestSize;
+
+  auto addRequest = [&](int i) { addStop(path, request.track[i], request.sector[i]); };
+
+  for (int start = 0; start < requestSize; start += batch)
+    {
+      int end = min(start + batch, requestSize);
+      int count = end - start;
+
+      for (int i = start; i < end; i++)
+	{
+	  order[i - start] = i;
+	}
+      // ties stay in arrival order, without the buffer stable_sort would allocate
+      sort(order, order + count, [&request](int a, int b) {
+	return request.track[a] < request.track[b] || (request.track[a] == request.track[b] && a < b);
+      });
+
+      if (up)
+	{
+	  // everything at or above the head, then the last track and back down for the rest
+	  int split = 0;
+	  while (split < count && request.track[order[split]] < currentTrack)
+	    split++;
+	  for (int i = split; i < count; i++)
+	    addRequest(order[i]);
+	  if (split > 0)
+	    {
+	      addEdgeStop(path, activeDisk.tracks - 1);
+	      for (int i = split - 1; i >= 0; i--)
+		addRequest(order[i]);
+	      up = false;
+	    }
+	}
+      else
+	{
+	  // everything at or below the head, then the first track and back up for the rest
+	  int split = count;
+	  while (split > 0 && request.track[order[split - 1]] > currentTrack)
+	    split--;
+	  for (int i = split - 1; i >= 0; i--)
+	    addRequest(order[i]);
+	  if (split < count)
+	    {
+	      addEdgeStop(path, 0);
+	      for (int i = split; i < count; i++)
+		addRequest(order[i]);
+	      up = true;
+	    }
+	}
+      currentTrack = path.track[path.stops - 1];
+    }
+
+  return (pathTime(path, histogram) / requestSize);
+}
+
+/***************************************************************************
+ * double satf(const requestQueue &, int, latencyHistogram *, pathScratch &)
+ * double satfModel(const Disk &, const requestQueue &, latencyHistogram *, pathScratch &)
+ * Date: 17 October 2026
+ * Description: simulates a shortest access time first scheduling
+ *algorithm, which always services the request with the smallest seek plus
+ *rotational latency from where the head is (checkSector included), not
+ *just the closest track. Ties go to the lowest index.
+ *Unaccessed points are kept in a doubly linked list over the sorted array
+ *(as in sstf) and candidates are tried outwards from the head in both
+ *directions. Going up, the seek only grows, so the search stops once the
+ *seek alone is more than the best access time found. Going down, the
+ *snapback keeps the seek under 1.5 + track * .0008, so the bound is the
+ *smaller of the seek and 1.5. The rotational latency is at most 6
+ *milliseconds, so with a full queue only the few hundred tracks around the
+ *head are ever looked at instead of the whole queue.
+ *satf() picks the disk model once and satfModel() does the work, so the
+ *classic disk keeps its compile time seek and cost arithmetic in the
+ *inner loops.
+ *Returns the average seek time in milliseconds.
+ *
+ * Parameters:
+ * disk I/P const Disk&  disk model the costs come from
+ * request I/P const requestQueue&  sorted queue of points that will be accessed in satf algorithm
+ * batch I/P int  not used
+ * histogram I/O latencyHistogram*  records the service time of every request, if not NULL
+ * scratch I/O pathScratch&  worker's scratch for the linked list
+ **************************************************************************/
+template <class Disk>
+double satfModel(const Disk &disk, const requestQueue &request, latencyHistogram *histogram, pathScratch &scratch)
+{
+  int requestSize = request.size; // number of points in the queue
+  double totalTime = 0; // initialize total time to 0 in milliseconds
+
+  double currentTrack = disk.startTrack; // start in the middle of the track
+  double currentSector = 0; // start at sector 0
+  int pending = 0; // number of points that have not been accessed
+
+  reservePath(scratch, requestSize);
+  int *prev = scratch.prev.data(); // previous unaccessed index, -1 if none
+  int *next = scratch.next.data(); // next unaccessed index, requestSize if none
+  int left = -1; // closest unaccessed index below the head
+  int right = requestSize; // closest unaccessed index at or above the head
+
+  pending = linkQueue(request, prev, next, currentTrack, left, right);
+
+  double *stepTime = scratch.seek.data(); // time of every step, for the histogram
+
+  for (int i = 0; i < pending; i++)
+    {
+      double best = HUGE_VAL; // smallest access time found
+      int closest = requestSize; // index of the point with that access time
+      double seek, rotation;
+
+      // upwards, until the seek alone is worse than the best
+      for (int n = right; n < requestSize; n = next[n])
+	{
+	  if (min(disk.seekTime(request.track[n] - currentTrack), disk.snapbackMs + disk.seekTime(request.track[n])) > best)
+	    break;
+
+	  stepCostModel(disk, currentTrack, currentSector, request.track[n], request.sector[n], seek, rotation);
+	  if (seek + rotation < best)
+	    {
+	      best = seek + rotation;
+	      closest = n;
+	    }
+	}
+
+      // downwards, until the smallest seek possible from here on is worse than the best
+      for (int n = left; n >= 0; n = prev[n])
+	{
+	  if (min(disk.seekTime(currentTrack - request.track[n]), disk.snapbackMs) > best)
+	    break;
+
+	  stepCostModel(disk, currentTrack, currentSector, request.track[n], request.sector[n], seek, rotation);
+	  if (seek + rotation <= best) // lower index wins a tie
+	    {
+	      best = seek + rotation;
+	      closest = n;
+	    }
+	}
+
+      // unlink the chosen point, its neighbours bracket the head's new track
+      left = prev[closest];
+      right = next[closest];
+      if (left >= 0)
+	next[left] = right;
+      if (right < requestSize)
+	prev[right] = left;
+
+      // move the head to the chosen point, adding the time it took
+      serviceStep(currentTrack, currentSector, request.track[closest], request.sector[closest], totalTime,
+		  histogram != NULL ? &stepTime[i] : NULL);
+    }
+
+  if (histogram != NULL)
+    recordPath(*histogram, stepTime, pending, totalTime);
+
+  // return average seek time in milliseconds
+  return (totalTime / requestSize);
+}
+
+double satf(const requestQueue &request, int /*batch*/, latencyHistogram *histogram, pathScratch &scratch)
+{
+  if (activeDisk.compiled)
+    return satfModel(classicDisk(), request, histogram, scratch);
+  return satfModel(activeDisk, request, histogram, scratch);
+}
+
+/***************************************************************************
+ * void startLane(schedulerLane &, const requestQueue &, latencyHistogram *, pathScratch &)
+ * Date: 17 October 2026
+ * Description: sets a schedulerLane up to run a scheduler on a queue.
+ *
+ * Parameters:
+ * lane O/P schedulerLane&  lane to be started
+ * request I/P const requestQueue&  queue the scheduler runs on
+ * histogram I/O latencyHistogram*  records the service time of every request, if not NULL
+ * scratch I/O pathScratch&  scratch of this lane alone
+ **************************************************************************/
+void startLane(schedulerLane &lane, const requestQueue &request, latencyHistogram *histogram, pathScratch &scratch)
+{
+  lane.request = &request;
+  lane.histogram = histogram;
+  lane.scratch = &scratch;
+  lane.stage = LANE_START;
+}
+
+/***************************************************************************
+ * void interleaveLanes(laneFunction, schedulerLane[], int)
+ * Date: 17 October 2026
+ * Description: runs a scheduler on several queues at once on one core.
+ *The lanes take turns one step at a time, so while one waits on the line
+ *it prefetched the others run, until every lane is done with its lookups.
+ *Then each lane is finished in turn, first to last, so the histogram gets
+ *the service times in the same order as running the queues back to back
+ *and the results are the same bit for bit.
+ *
+ * Parameters:
+ * step I/P laneFunction  the scheduler's lane (see schedulerInfo)
+ * lane I/O schedulerLane[]  lanes started by startLane, averages out
+ * width I/P int  number of lanes
+ **************************************************************************/
+void interleaveLanes(laneFunction step, schedulerLane lane[], int width)
+{
+  int running = width; // lanes still doing lookups
+
+  while (running > 0)
+    {
+      running = 0;
+      for (int w = 0; w < width; w++)
+	{
+	  if (lane[w].stage != LANE_FINISH && step(lane[w]))
+	    running++;
+	}
+    }
+  for (int w = 0; w < width; w++)
+    {
+      step(lane[w]);
+    }
+}
+
+/***************************************************************************
+ * SCHEDULERS
+ * Date: 17 October 2026
+ * Description: every scheduler that can be picked with --schedulers, with
+ *the queue its batch version takes, its lane for --interleave and its
+ *--simulate policy. fscan freezes the queue at the start of a sweep; in the
+ *sweep and --trace the whole request is queued before the first sweep, so
+ *there it is the same as scan.
+ **************************************************************************/
+const schedulerInfo SCHEDULERS[] = {
+  { "fifo", "FIFO", fifo, NULL, false, ONLINE_FIFO },
+  { "sstf", "SSTF", sstf, sstfLane, true, ONLINE_SSTF },
+  { "scan", "SCAN", scan, scanLane, true, ONLINE_SCAN },
+  { "cscan", "C-SCAN", cscan, cscanLane, true, ONLINE_CSCAN },
+  { "look", "LOOK", look, NULL, true, ONLINE_LOOK },
+  { "clook", "C-LOOK", clook, NULL, true, ONLINE_CLOOK },
+  { "nstep", "N-SCAN", nstep, NULL, false, ONLINE_NSTEP },
+  { "fscan", "FSCAN", scan, scanLane, true, ONLINE_FSCAN },
+  { "satf", "SATF", satf, NULL, true, ONLINE_SATF },
+};
+const int NUM_SCHEDULERS = sizeof(SCHEDULERS) / sizeof(SCHEDULERS[0]);
+
+/***************************************************************************
+ * const schedulerInfo *findScheduler(const char *, size_t)
+ * Date: 17 October 2026
+ * Description: looks up a scheduler by name.
+ *
+ * Parameters:
+ * name I/P const char*  name of the scheduler, need not be terminated
+ * length I/P size_t  length of the name
+ * findScheduler O/P const schedulerInfo*  the scheduler, NULL if the name is not known
+ **************************************************************************/
+const schedulerInfo *findScheduler(const char *name, size_t length)
+{
+  for (int i = 0; i < NUM_SCHEDULERS; i++)
+    {
+      if (strlen(SCHEDULERS[i].name) == length && strncmp(SCHEDULERS[i].name, name, length) == 0)
+	return &SCHEDULERS[i];
+    }
+  return NULL;
+}
+
+/***************************************************************************
+ * bool parseSchedulers(const char *, vector<const schedulerInfo *> &)
+ * Date: 17 October 2026
+ * Description: reads a comma separated list of scheduler names (or "all").
+ *
+ * Parameters:
+ * list I/P const char*  list of names, e.g. fifo,sstf,satf
+ * schedulers O/P vector<const schedulerInfo *>&  the schedulers, in list order
+ * parseSchedulers O/P bool  false if a name is not known or the list is empty
+ **************************************************************************/
+bool parseSchedulers(const char *list, vector<const schedulerInfo *> &schedulers)
+{
+  schedulers.clear();
+  if (strcmp(list, "all") == 0)
+    {
+      for (int i = 0; i < NUM_SCHEDULERS; i++)
+	{
+	  schedulers.push_back(&SCHEDULERS[i]);
+	}
+      return true;
+    }
+
+  while (*list != '\0')
+    {
+      size_t length = strcspn(list, ",");
+      const schedulerInfo *scheduler = findScheduler(list, length);
+
+      if (scheduler == NULL)
+	return false;
+      schedulers.push_back(scheduler);
+      list += length;
+      if (*list == ',')
+	list++;
+    }
+  return !schedulers.empty();
+}
+
+/***************************************************************************
+ * void clearAddresses(addressSet &, int)
+ * Date: 17 October 2026
+ * Description: empties set and makes sure it can hold size addresses while
+ *staying at most half full. The slots are reused between experiments, so
+ *once it has grown no more memory is allocated.
+ *
+ * Parameters:
+ * set I/O addressSet&  set to be emptied
+ * size I/P int  number of addresses that will be inserted
+ **************************************************************************/
+void clearAddresses(addressSet &set, int size)
+{
+  size_t capacity = 16;
+
+  while (capacity < (size_t)size * 2)
+    capacity *= 2;
+
+  if (set.slots.size() < capacity)
+    set.slots.resize(capacity);
+  set.mask = capacity - 1;
+  fill(set.slots.begin(), set.slots.begin() + capacity, 0);
+}
+
+/***************************************************************************
+ * bool insertAddress(addressSet &, uint32_t)
+ * Date: 17 October 2026
+ * Description: adds address to set with linear probing.
+ *
+ * Parameters:
+ * set I/O addressSet&  set the address is added to
+ * address I/P uint32_t  track * 12000 + sector
+ * insertAddress O/P bool  false if the address was already in the set
+ **************************************************************************/
+bool insertAddress(addressSet &set, uint32_t address)
+{
+  uint32_t slot = (address * 0x9E3779B1u) & set.mask;
+
+  while (set.slots[slot] != 0)
+    {
+      if (set.slots[slot] == address + 1)
+	return false;
+      slot = (slot + 1) & set.mask;
+    }
+  set.slots[slot] = address + 1; // slots store address + 1 so 0 means empty
+  return true;
+}
+
+/***************************************************************************
+ * void generateRequest(point[], int, rngStream &, workerArena &)
+ * Date: 17 October 2026
+ * Description: fills request with size uniform random points with no
+ *duplicates. A point is drawn as one uniform address (track * 12000 +
+ *sector, the same as a uniform track and a uniform sector), all of them in
+ *one batch, and drawn again if it is already in the request. Checking for duplicates uses a hash set so
+ *it is O(1) per point instead of searching the whole request.
+ *
+ * Parameters:
+ * request O/P point[]  array of points to be filled in arrival order
+ * size I/P int  number of points to generate
+ * rng I/O rngStream&  random stream the points are drawn from
+ * arena I/O workerArena&  scratch set of addresses already in the request and buffer of bulk draws
+ **************************************************************************/
+void generateRequest(point request[], int size, rngStream &rng, workerArena &arena)
+{
+  const int addresses = activeDisk.addresses;
+  addressSet &seen = arena.seen;
+
+  if ((int)arena.draws.size() < size)
+    arena.draws.resize(size);
+  uint32_t *draws = arena.draws.data(); // addresses drawn in bulk
+
+  clearAddresses(seen, size);
+  fillUniform(rng, 0, addresses - 1, draws, size);
+
+  // fill points with uniform random numbers for I/O requests
+  for (int i = 0; i < size; i++)
+    {
+      uint32_t address = draws[i];
+
+      // draw again until the point is not already in the request
+      while (!insertAddress(seen, address))
+	{
+	  address = uniform(rng, 0, addresses - 1);
+	}
+
+      request[i] = addressPoint(address);
+    } // end of generating I/O requests
+}
+
+/***************************************************************************
+ * void sampleRequest(point[], int, rngStream &, workerArena &)
+ * Date: 17 October 2026
+ * Description: fills request with size distinct uniform random points by
+ *sampling without replacement, so nothing is ever drawn again. Robert
+ *Floyd's algorithm picks the set of addresses (one draw per point even when
+ *the request covers most of the disk), then a Fisher-Yates shuffle puts them
+ *in a uniformly random arrival order, since the order Floyd's algorithm
+ *picks them in is not uniform.
+ *
+ * Parameters:
+ * request O/P point[]  array of points to be filled in arrival order
+ * size I/P int  number of points to generate, at most 5000 * 12000
+ * rng I/O rngStream&  random stream the points are drawn from
+ * arena I/O workerArena&  scratch set of addresses already in the request
+ **************************************************************************/
+void sampleRequest(point request[], int size, rngStream &rng, workerArena &arena)
+{
+  const int addresses = activeDisk.addresses;
+  addressSet &seen = arena.seen;
+  int i = 0;
+
+  clearAddresses(seen, size);
+
+  // Floyd: for each of the last size addresses j, take a random address in 0-j, or j itself if that one is taken
+  for (int j = addresses - size; j < addresses; j++, i++)
+    {
+      uint32_t address = uniform(rng, 0, j);
+
+      if (!insertAddress(seen, address))
+	{
+	  address = j;
+	  insertAddress(seen, address);
+	}
+      request[i] = addressPoint(address);
+    }
+
+  // shuffle into a random arrival order
+  for (i = size - 1; i > 0; i--)
+    {
+      swap(&request[i], &request[uniform(rng, 0, i)]);
+    }
+}
+
+/***************************************************************************
+ * uint32_t workloadAddress(uint32_t, const uint32_t[], bool, uint32_t)
+ * Date: 17 October 2026
+ * Description: address of one request of activeWorkload, from a uniform
+ *alias table column and three random words: the alias coin, the sector and
+ *the sequential coin. The sector is scaled by multiply and shift, off
+ *uniform by under sectors / 2^32.
+ *
+ * Parameters:
+ * column I/P uint32_t  uniform random track, the alias table column
+ * word I/P const uint32_t[]  alias coin, sector word and sequential coin
+ * continues I/P bool  whether there is a request before this one to continue
+ * previous I/P uint32_t  address of the request before this one
+ * workloadAddress O/P uint32_t  the address
+ **************************************************************************/
+inline uint32_t workloadAddress(uint32_t column, const uint32_t word[], bool continues, uint32_t previous)
+{
+  const workloadModel &workload = activeWorkload;
+
+  if (continues && word[2] < workload.sequentialCoin)
+    return (previous + 1) % activeDisk.addresses; // next sector, or the start of the next track
+
+  uint32_t track = (word[0] < workload.threshold[column]) ? column : workload.alias[column];
+  uint32_t sector = ((uint64_t)word[1] * activeDisk.sectorCount[track]) >> 32;
+
+  return workload.trackAddress[track] + sector;
+}
+
+/***************************************************************************
+ * void workloadRequest(point[], int, rngStream &, workerArena &)
+ * Date: 17 October 2026
+ * Description: fills request with size points of activeWorkload. Every
+ *random number the request needs is drawn in bulk up front (the alias
+ *columns with fillUniform, the other words with fillRandom), so the loop
+ *over the points is only table lookups. A point already in the request is
+ *handled by the workload's duplicate policy: reject draws it again (and
+ *shifts it after REJECT_TRIES draws, so a workload narrower than the
+ *request still ends), shift moves it on to the next free address and allow
+ *keeps it, so the queue holds the same point twice.
+ *
+ * Parameters:
+ * request O/P point[]  array of points to be filled in arrival order
+ * size I/P int  number of points to generate
+ * rng I/O rngStream&  random stream the points are drawn from
+ * arena I/O workerArena&  scratch set of addresses already in the request and buffers of bulk draws
+ **************************************************************************/
+void workloadRequest(point request[], int size, rngStream &rng, workerArena &arena)
+{
+  const workloadModel &workload = activeWorkload;
+  const bool unique = (workload.duplicates != DUPLICATES_ALLOW);
+  addressSet &seen = arena.seen;
+  uint32_t previous = 0;
+
+  if ((int)arena.draws.size() < size)
+    arena.draws.resize(size);
+  if (arena.words.size() < (size_t)size * 3)
+    arena.words.resize((size_t)size * 3);
+  uint32_t *column = arena.draws.data(); // alias table columns
+  uint32_t *word = arena.words.data(); // three words per point, see workloadAddress
+
+  if (unique)
+    clearAddresses(seen, size);
+  fillUniform(rng, 0, activeDisk.tracks - 1, column, size);
+  fillRandom(rng, word, size * 3);
+
+  for (int i = 0; i < size; i++)
+    {
+      uint32_t address = workloadAddress(column[i], word + (size_t)i * 3, i > 0, previous);
+
+      for (int tries = 1; unique && !insertAddress(seen, address); tries++)
+	{
+	  if (workload.duplicates == DUPLICATES_SHIFT || tries >= REJECT_TRIES)
+	    address = (address + 1) % activeDisk.addresses;
+	  else
+	    {
+	      uint32_t redraw[3] = { nextRandom(rng), nextRandom(rng), nextRandom(rng) };
+	      address = workloadAddress(uniform(rng, 0, activeDisk.tracks - 1), redraw, i > 0, previous);
+	    }
+	}
+
+      request[i] = addressPoint(address);
+      previous = address;
+    }
+}
+
+/***************************************************************************
+ * generatorFunction findGenerator(const char *)
+ * Date: 17 October 2026
+ * Description: looks up a request generator by name (rejection or floyd).
+ *
+ * Parameters:
+ * name I/P const char*  name of the generator
+ * findGenerator O/P generatorFunction  the generator, NULL if the name is not known
+ **************************************************************************/
+generatorFunction findGenerator(const char *name)
+{
+  if (strcmp(name, "rejection") == 0)
+    return generateRequest;
+  if (strcmp(name, "floyd") == 0)
+    return sampleRequest;
+  if (strcmp(name, "workload") == 0)
+    return workloadRequest;
+  return NULL;
+}
+
+/***************************************************************************
+ * string generatorName(const simulationOptions &)
+ * Date: 17 October 2026
+ * Description: describes the request generator of a sweep, with every
+ *setting of activeWorkload if it is the workload generator.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  options of the sweep
+ * generatorName O/P string  the description
+ **************************************************************************/
+string generatorName(const simulationOptions &opts)
+{
+  if (opts.generator == sampleRequest)
+    return "floyd";
+  if (opts.generator != workloadRequest)
+    return "rejection";
+
+  const workloadModel &workload = activeWorkload;
+  string name = "workload zipf " + to_string(workload.zipf) + " sequential " + to_string(workload.sequential) +
+		" duplicates " + DUPLICATE_NAMES[workload.duplicates];
+
+  for (const workloadZone &zone : workload.zones)
+    {
+      name += " zone " + to_string(zone.firstTrack) + "-" + to_string(zone.lastTrack) + ":" + to_string(zone.weight);
+    }
+  return name;
+}
+
+/***************************************************************************
+ * bool buildWorkload(workloadModel &)
+ * Date: 17 October 2026
+ * Description: sets up the tables of a workload for activeDisk: folds its
+ *zones into one share per track, builds the alias table of the shares
+ *with Vose's method (every column split between its own track and one
+ *other, so a draw is one uniform column and one coin), and works out the
+ *address every track starts at.
+ *
+ * Parameters:
+ * workload I/O workloadModel&  workload whose zipf, zones and sequential are set
+ * buildWorkload O/P bool  false if a zone is not on the disk or has no weight
+ **************************************************************************/
+bool buildWorkload(workloadModel &workload)
+{
+  const int tracks = activeDisk.tracks;
+  vector<workloadZone> zones = workload.zones;
+  vector<double> share(tracks, 0);
+  double total = 0;
+
+  if (zones.empty())
+    zones.push_back(workloadZone{ 0, tracks - 1, 1 });
+  for (const workloadZone &zone : zones)
+    {
+      double zoneTotal = 0;
+
+      if (zone.firstTrack < 0 || zone.lastTrack >= tracks || zone.firstTrack > zone.lastTrack || !(zone.weight > 0))
+	{
+	  cerr << "zone " << zone.firstTrack << "-" << zone.lastTrack << ":" << zone.weight << " is not on the " << tracks
+	       << " tracks of the disk or has no weight\n";
+	  return false;
+	}
+      for (int track = zone.firstTrack; track <= zone.lastTrack; track++)
+	{
+	  zoneTotal += (workload.zipf > 0) ? pow(track - zone.firstTrack + 1, -workload.zipf) : activeDisk.sectorCount[track];
+	}
+      for (int track = zone.firstTrack; track <= zone.lastTrack; track++)
+	{
+	  double weight = (workload.zipf > 0) ? pow(track - zone.firstTrack + 1, -workload.zipf) : activeDisk.sectorCount[track];
+
+	  share[track] += zone.weight * weight / zoneTotal;
+	}
+      total += zone.weight;
+    }
+
+  // Vose: pair each column under the average with one over it
+  vector<int> small, large;
+  workload.threshold.assign(tracks, 0);
+  workload.alias.resize(tracks);
+  for (int track = 0; track < tracks; track++)
+    {
+      share[track] *= tracks / total; // 1 is the average share
+      (share[track] < 1 ? small : large).push_back(track);
+    }
+  while (!small.empty() && !large.empty())
+    {
+      int under = small.back(), over = large.back();
+
+      small.pop_back();
+      large.pop_back();
+      workload.threshold[under] = (uint32_t)(share[under] * 4294967296.0);
+      workload.alias[under] = over;
+      share[over] -= 1 - share[under];
+      (share[over] < 1 ? small : large).push_back(over);
+    }
+  for (int track : small) // only left by rounding, so they are full columns
+    large.push_back(track);
+  for (int track : large)
+    {
+      workload.threshold[track] = 0xFFFFFFFFu;
+      workload.alias[track] = track;
+    }
+
+  uint32_t address = 0;
+  workload.trackAddress.resize(tracks);
+  for (int track = 0; track < tracks; track++)
+    {
+      workload.trackAddress[track] = address;
+      address += activeDisk.sectorCount[track];
+    }
+  workload.sequentialCoin = (uint32_t)min(4294967295.0, workload.sequential * 4294967296.0);
+  return true;
+}
+
+/***************************************************************************
+ * void reserveArena(workerArena &, int)
+ * Date: 17 October 2026
+ * Description: grows every buffer of arena to hold a request of size
+ *points, so experiments up to that size run without allocating.
+ *
+ * Parameters:
+ * arena I/O workerArena&  arena to be grown
+ * size I/P int  largest request the arena will hold
+ **************************************************************************/
+void reserveArena(workerArena &arena, int size)
+{
+  if ((int)arena.request.size() < size)
+    {
+      arena.request.resize(size);
+      arena.order.resize(size);
+      arena.draws.resize(size);
+    }
+  arena.trackStart.resize(max<size_t>(arena.trackStart.size(), activeDisk.tracks + 1));
+  resizeQueue(arena.arrival, size);
+  resizeQueue(arena.sorted, size);
+  clearAddresses(arena.seen, size);
+  reservePath(arena.path, size);
+}
+
+/***************************************************************************
+ * void reserveLanes(workerArena &, int, int)
+ * Date: 17 October 2026
+ * Description: gives arena the lanes to run width experiments side by side
+ *(see runTile), the arena's own queues being the first, each grown to
+ *hold a request of size points.
+ *
+ * Parameters:
+ * arena I/O workerArena&  arena to be grown
+ * width I/P int  experiments run side by side
+ * size I/P int  largest request the lanes will hold
+ **************************************************************************/
+void reserveLanes(workerArena &arena, int width, int size)
+{
+  if ((int)arena.lanes.size() < width - 1)
+    arena.lanes.resize(width - 1);
+  for (experimentLane &lane : arena.lanes)
+    {
+      resizeQueue(lane.arrival, size);
+      resizeQueue(lane.sorted, size);
+      reservePath(lane.path, size);
+    }
+}
+
+/***************************************************************************
+ * void closeTrace(traceReader &)
+ * Date: 17 October 2026
+ * Description: closes the file of a trace reader.
+ *
+ * Parameters:
+ * reader I/O traceReader&  reader to be closed
+ **************************************************************************/
+void closeTrace(traceReader &reader)
+{
+  if (reader.file != NULL && reader.file != stdin)
+    fclose(reader.file);
+  reader.file = NULL;
+}
+
+/***************************************************************************
+ * bool openTrace(traceReader &, const char *, const char *)
+ * Date: 17 October 2026
+ * Description: opens a block I/O trace for streaming. The format is
+ *blkparse (text output of blkparse), msr (SNIA / MSR-Cambridge CSV) or
+ *binary (see writeTraceRecord). If format is NULL it is picked from the
+ *file name: .csv is msr, .bin is binary, anything else blkparse.
+ *
+ * Parameters:
+ * reader O/P traceReader&  reader to be opened
+ * path I/P const char*  file name of the trace, "-" for standard in
+ * format I/P const char*  format of the trace, or NULL
+ * openTrace O/P bool  false if the file could not be opened or the format is unknown
+ **************************************************************************/
+bool openTrace(traceReader &reader, const char *path, const char *format)
+{
+  const char *extension = strrchr(path, '.');
+
+  if (format == NULL)
+    {
+      if (extension != NULL && strcmp(extension, ".csv") == 0)
+	format = "msr";
+      else if (extension != NULL && strcmp(extension, ".bin") == 0)
+	format = "binary";
+      else
+	format = "blkparse";
+    }
+
+  if (strcmp(format, "blkparse") == 0)
+    reader.format = TRACE_BLKPARSE;
+  else if (strcmp(format, "msr") == 0)
+    reader.format = TRACE_MSR;
+  else if (strcmp(format, "binary") == 0)
+    reader.format = TRACE_BINARY;
+  else
+    return false;
+
+  reader.file = (strcmp(path, "-") == 0) ? stdin : fopen(path, "rb");
+  if (reader.file == NULL)
+    return false;
+
+  reader.buffer.resize(TRACE_BUFFER_BYTES);
+  reader.begin = 0;
+  reader.end = 0;
+  reader.eof = false;
+  reader.records = 0;
+  reader.skipped = 0;
+  reader.firstTime = 0;
+
+  // binary traces start with a magic number
+  if (reader.format == TRACE_BINARY)
+    {
+      char magic[sizeof(TRACE_MAGIC)];
+      if (fread(magic, 1, sizeof(magic), reader.file) != sizeof(magic) || memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0)
+	{
+	  closeTrace(reader);
+	  return false;
+	}
+    }
+  return true;
+}
+
+/***************************************************************************
+ * bool fillTraceBuffer(traceReader &)
+ * Date: 17 October 2026
+ * Description: moves the unread bytes to the front of the buffer and reads
+ *the next chunk of the file after them. The buffer never grows, so a trace
+ *of any size is read with the same memory.
+ *
+ * Parameters:
+ * reader I/O traceReader&  reader to be refilled
+ * fillTraceBuffer O/P bool  false if nothing more could be read
+ **************************************************************************/
+bool fillTraceBuffer(traceReader &reader)
+{
+  size_t left = reader.end - reader.begin;
+
+  if (reader.eof || left == reader.buffer.size())
+    return false;
+
+  memmove(reader.buffer.data(), reader.buffer.data() + reader.begin, left);
+  reader.begin = 0;
+  reader.end = left;
+
+  size_t got = fread(reader.buffer.data() + left, 1, reader.buffer.size() - left, reader.file);
+  reader.end += got;
+  if (got == 0)
+    reader.eof = true;
+  return got > 0;
+}
+
+/***************************************************************************
+ * bool parseBlkparseLine(char *, traceRecord &)
+ * Date: 17 October 2026
+ * Description: parses one line of blkparse output, for example
+ *"  8,0    3        1     0.000000000   697  Q   W 223490 + 8 [kjournald]".
+ *Only Q (queued) events are used, since that is when the request arrives
+ *at the scheduler.
+ *
+ * Parameters:
+ * line I/P char*  NUL terminated line
+ * record O/P traceRecord&  parsed record
+ * parseBlkparseLine O/P bool  false if the line is not a queued request
+ **************************************************************************/
+bool parseBlkparseLine(char *line, traceRecord &record)
+{
+  char *field[10];
+  char *save = NULL;
+  int fields = 0;
+
+  for (char *token = strtok_r(line, " \t\r", &save); token != NULL && fields < 10; token = strtok_r(NULL, " \t\r", &save))
+    {
+      field[fields++] = token;
+    }
+
+  // device cpu sequence time pid action rwbs sector + blocks
+  if (fields < 9 || strcmp(field[5], "Q") != 0 || strcmp(field[8], "+") != 0)
+    return false;
+
+  record.time = strtod(field[3], NULL);
+  record.lba = strtoull(field[7], NULL, 10);
+  record.length = (fields == 10) ? strtoul(field[9], NULL, 10) : 0;
+  record.write = (strchr(field[6], 'W') != NULL);
+  return true;
+}
+
+/***************************************************************************
+ * bool parseMsrLine(char *, traceRecord &)
+ * Date: 17 October 2026
+ * Description: parses one line of an MSR-Cambridge style CSV trace,
+ *"Timestamp,Hostname,DiskNumber,Type,Offset,Size,ResponseTime", where the
+ *offset and size are in bytes and the timestamp is in 100 ns ticks.
+ *
+ * Parameters:
+ * line I/P char*  NUL terminated line
+ * record O/P traceRecord&  parsed record
+ * parseMsrLine O/P bool  false if the line is not a request (a header for example)
+ **************************************************************************/
+bool parseMsrLine(char *line, traceRecord &record)
+{
+  char *field[6];
+  int fields = 0;
+
+  field[fields++] = line;
+  for (char *c = line; *c != '\0' && fields < 6; c++)
+    {
+      if (*c == ',')
+	{
+	  *c = '\0';
+	  field[fields++] = c + 1;
+	}
+    }
+
+  if (fields < 6 || *field[4] < '0' || *field[4] > '9')
+    return false;
+
+  record.time = strtod(field[0], NULL) * 1e-7;
+  record.lba = strtoull(field[4], NULL, 10) / TRACE_LBA_BYTES;
+  record.length = strtoul(field[5], NULL, 10) / TRACE_LBA_BYTES;
+  record.write = (field[3][0] == 'W' || field[3][0] == 'w');
+  return true;
+}
+
+/***************************************************************************
+ * int checkTrace()
+ * Date: 17 October 2026
+ * Description: checks the text trace parsers against fixture lines
+ *(--check-trace): queued blkparse requests with and without a process name,
+ *blkparse events and summary lines that are not requests, and MSR-Cambridge
+ *requests and headers. Every field of a parsed record must match.
+ *
+ * Parameters:
+ * checkTrace O/P int  status code, 1 if any line was parsed wrongly
+ **************************************************************************/
+int checkTrace()
+{
+  struct traceFixture
+  {
+    int format; // TRACE_BLKPARSE or TRACE_MSR
+    const char *line; // line as read from the trace
+    bool parsed; // whether the line is a request
+    traceRecord record; // the request, when it is one
+  };
+  const traceFixture fixtures[] = {
+    { TRACE_BLKPARSE, "  8,0    3        1     0.000000000   697  Q   W 223490 + 8 [kjournald]", true, { 0.0, 223490, 8, true } },
+    { TRACE_BLKPARSE, "  8,16   0       12     1.250000000  4711  Q   R 1048576 + 64 [fio]", true, { 1.25, 1048576, 64, false } },
+    { TRACE_BLKPARSE, "  8,0    1        7     2.500000000   697  Q  WS 4096 + 256", true, { 2.5, 4096, 256, true } },
+    { TRACE_BLKPARSE, "  8,0    3        2     0.000010000   697  G   W 223490 + 8 [kjournald]", false, {} },
+    { TRACE_BLKPARSE, "CPU3 (8,0):", false, {} },
+    { TRACE_MSR, "128166372003061629,wdev,0,Write,2186485760,65536,1119", true, { 12816637200.3061629, 4270480, 128, true } },
+    { TRACE_MSR, "128166372016382155,wdev,0,Read,4096,512,2150", true, { 12816637201.6382155, 8, 1, false } },
+    { TRACE_MSR, "Timestamp,Hostname,DiskNumber,Type,Offset,Size,ResponseTime", false, {} },
+  };
+  bool same = true;
+
+  cout << "Format		Parsed	Time		LBA		Blocks	Write	Result\n";
+  for (const traceFixture &fixture : fixtures)
+    {
+      char line[128];
+      traceRecord record = {};
+
+      snprintf(line, sizeof(line), "%s", fixture.line);
+      bool parsed = (fixture.format == TRACE_MSR) ? parseMsrLine(line, record) : parseBlkparseLine(line, record);
+      bool match = parsed == fixture.parsed &&
+		   (!parsed || (fabs(record.time - fixture.record.time) <= 1e-12 * fabs(fixture.record.time) && record.lba == fixture.record.lba &&
+				record.length == fixture.record.length && record.write == fixture.record.write));
+
+      cout << (fixture.format == TRACE_MSR ? "msr\t" : "blkparse") << "\t" << (parsed ? "yes" : "no") << "\t"
+	   << record.time << "\t\t" << record.lba << "\t\t" << record.length << "\t"
+	   << (record.write ? "yes" : "no") << "\t" << (match ? "ok" : "WRONG") << "\n";
+      same &= match;
+    }
+  return same ? 0 : 1;
+}
+
+/***************************************************************************
+ * bool nextTraceRecord(traceReader &, traceRecord &)
+ * Date: 17 October 2026
+ * Description: reads the next request from the trace, skipping lines that
+ *are not requests.
+ *
+ * Parameters:
+ * reader I/O traceReader&  reader to read from
+ * record O/P traceRecord&  next request
+ * nextTraceRecord O/P bool  false at the end of the trace
+ **************************************************************************/
+bool nextTraceRecord(traceReader &reader, traceRecord &record)
+{
+  if (reader.format == TRACE_BINARY)
+    {
+      if (reader.end - reader.begin < TRACE_RECORD_BYTES && !fillTraceBuffer(reader))
+	return false;
+      if (reader.end - reader.begin < TRACE_RECORD_BYTES)
+	return false;
+
+      // little endian: double time, uint64 lba, uint32 length, uint32 flags
+      const char *data = reader.buffer.data() + reader.begin;
+      uint32_t flags;
+      memcpy(&record.time, data, 8);
+      memcpy(&record.lba, data + 8, 8);
+      memcpy(&record.length, data + 16, 4);
+      memcpy(&flags, data + 20, 4);
+      record.write = (flags & 1);
+      reader.begin += TRACE_RECORD_BYTES;
+      if (reader.records++ == 0)
+	reader.firstTime = record.time;
+      return true;
+    }
+
+  while (true)
+    {
+      char *start = reader.buffer.data() + reader.begin;
+      char *newline = (char *)memchr(start, '\n', reader.end - reader.begin);
+
+      if (newline == NULL)
+	{
+	  // no full line left, read more or take what is left as the last line
+	  if (fillTraceBuffer(reader))
+	    continue;
+	  if (reader.begin == reader.end)
+	    return false;
+	  if (reader.end == reader.buffer.size())
+	    reader.end--; // line longer than the buffer, cut it
+	  start = reader.buffer.data() + reader.begin;
+	  newline = reader.buffer.data() + reader.end;
+	}
+
+      *newline = '\0';
+      reader.begin = newline - reader.buffer.data() + 1;
+      if (reader.begin > reader.end)
+	reader.begin = reader.end;
+
+      bool parsed = (reader.format == TRACE_MSR) ? parseMsrLine(start, record) : parseBlkparseLine(start, record);
+      if (parsed)
+	{
+	  if (reader.records++ == 0)
+	    reader.firstTime = record.time;
+	  return true;
+	}
+      reader.skipped++;
+    }
+}
+
+/***************************************************************************
+ * void writeTraceRecord(FILE *, const traceRecord &)
+ * Date: 17 October 2026
+ * Description: writes one record in the binary trace format: 24 bytes,
+ *little endian double time (seconds), uint64 lba, uint32 length (blocks)
+ *and uint32 flags (bit 0 set for writes), after a TRACE_MAGIC header
+ *written by the caller.
+ *
+ * Parameters:
+ * file I/P FILE*  binary trace being written
+ * record I/P const traceRecord&  record to be written
+ **************************************************************************/
+void writeTraceRecord(FILE *file, const traceRecord &record)
+{
+  char data[TRACE_RECORD_BYTES];
+  uint32_t flags = record.write ? 1 : 0;
+
+  memcpy(data, &record.time, 8);
+  memcpy(data + 8, &record.lba, 8);
+  memcpy(data + 16, &record.length, 4);
+  memcpy(data + 20, &flags, 4);
+  fwrite(data, 1, sizeof(data), file);
+}
+
+/***************************************************************************
+ * point tracePoint(const traceRecord &, uint64_t)
+ * Date: 17 October 2026
+ * Description: maps a trace record onto the simulated disk. The lba is
+ *divided by lbasPerSector and wrapped around the sectors of the disk,
+ *track first (see addressPoint).
+ *
+ * Parameters:
+ * record I/P const traceRecord&  record to be mapped
+ * lbasPerSector I/P uint64_t  trace blocks per simulated sector
+ * tracePoint O/P point  the point the record accesses
+ **************************************************************************/
+point tracePoint(const traceRecord &record, uint64_t lbasPerSector)
+{
+  return addressPoint((record.lba / lbasPerSector) % activeDisk.addresses);
+}
+
+/***************************************************************************
+ * int replayTrace(const simulationOptions &)
+ * Date: 17 October 2026
+ * Description: replays a block I/O trace through the selected schedulers
+ *instead of generating random requests. The trace is streamed in windows of
+ *opts.window requests (the queue the scheduler sees), so only one window
+ *is ever in memory. Prints the average seek time of each scheduler over
+ *the whole trace with its percentiles, and the replay throughput. With opts.traceOut the records
+ *are also written out in the binary trace format.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  trace file, format, window and geometry
+ * replayTrace O/P int  status code, 1 if the trace could not be read
+ **************************************************************************/
+int replayTrace(const simulationOptions &opts)
+{
+  traceReader reader;
+  traceRecord record;
+  workerArena arena;
+  requestQueue &arrival = arena.arrival, &sorted = arena.sorted;
+  int count = opts.schedulers.size();
+  unique_ptr<latencyHistogram[]> histogram(new latencyHistogram[count]);
+  uint64_t windows = 0, serviced = 0;
+  FILE *out = NULL;
+  bool more = true;
+
+  if (!openTrace(reader, opts.trace, opts.traceFormat))
+    {
+      cerr << "could not read trace " << opts.trace << "\n";
+      return 1;
+    }
+  if (opts.traceOut != NULL)
+    {
+      out = fopen(opts.traceOut, "wb");
+      if (out == NULL)
+	{
+	  cerr << "could not write " << opts.traceOut << "\n";
+	  closeTrace(reader);
+	  return 1;
+	}
+      fwrite(TRACE_MAGIC, 1, sizeof(TRACE_MAGIC), out);
+    }
+
+  for (int alg = 0; alg < count; alg++)
+    {
+      clearHistogram(histogram[alg]);
+    }
+  reserveArena(arena, opts.window);
+
+  auto start = chrono::steady_clock::now();
+
+  while (more)
+    {
+      int size = 0;
+
+      // fill the next window
+      while (size < opts.window && (more = nextTraceRecord(reader, record)))
+	{
+	  if (out != NULL)
+	    writeTraceRecord(out, record);
+	  arena.request[size++] = tracePoint(record, opts.lbasPerSector);
+	}
+      if (size == 0)
+	break;
+
+      opts.sorter(arena.request.data(), size, arena.order.data(), arena);
+      loadQueue(arrival, arena.request.data(), size);
+      loadSortedQueue(sorted, arena.request.data(), arena.order.data(), size);
+
+      // the histograms give the mean as well as the percentiles, so the averages are not needed
+      for (int alg = 0; alg < count; alg++)
+	{
+	  const requestQueue &queue = opts.schedulers[alg]->sorted ? sorted : arrival;
+
+	  opts.schedulers[alg]->run(queue, opts.nstep, &histogram[alg], arena.path);
+	}
+
+      windows++;
+      serviced += size;
+    }
+
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  closeTrace(reader);
+  if (out != NULL)
+    fclose(out);
+
+  cout << "Trace: " << opts.trace << "\n";
+  cout << "Records: " << serviced << " (" << reader.skipped << " lines skipped) in " << windows
+       << " windows of " << opts.window << "\n";
+  cout << "Replay: " << elapsed.count() << " s, " << (serviced / elapsed.count()) << " records/sec\n";
+  outputPercentiles(cout, histogram.get(), 1, opts.schedulers);
+  return 0;
+}
+
+/***************************************************************************
+ * double uniformReal(rngStream &)
+ * Date: 17 October 2026
+ * Description: uniform random double in (0, 1], with 53 random bits.
+ *
+ * Parameters:
+ * rng I/O rngStream&  stream to draw from
+ **************************************************************************/
+double uniformReal(rngStream &rng)
+{
+  uint64_t high = nextRandom(rng);
+  uint64_t bits = (high << 32 | nextRandom(rng)) >> 11;
+  return (bits + 1) * (1.0 / 9007199254740992.0);
+}
+
+/***************************************************************************
+ * bool eventBefore(const eventQueue &, int, int)
+ * Date: 17 October 2026
+ * Description: returns whether event a happens before event b. Events at
+ *the same time happen in the order they were scheduled, which keeps runs
+ *deterministic.
+ *
+ * Parameters:
+ * queue I/P const eventQueue&  queue holding the events
+ * a I/P int  pool index of the first event
+ * b I/P int  pool index of the second event
+ **************************************************************************/
+inline bool eventBefore(const eventQueue &queue, int a, int b)
+{
+  const simEvent &x = queue.pool[a];
+  const simEvent &y = queue.pool[b];
+  return x.time < y.time || (x.time == y.time && x.sequence < y.sequence);
+}
+
+/***************************************************************************
+ * void scheduleEvent(eventQueue &, double, int, int)
+ * Date: 17 October 2026
+ * Description: adds an event to the queue, reusing a free pool entry if
+ *there is one.
+ *
+ * Parameters:
+ * queue I/O eventQueue&  queue the event is added to
+ * time I/P double  time of the event in milliseconds
+ * type I/P int  EVENT_ARRIVAL or EVENT_COMPLETION
+ * request I/P int  request the event is about
+ **************************************************************************/
+void scheduleEvent(eventQueue &queue, double time, int type, int request)
+{
+  int event;
+
+  if (queue.freeEvents.empty())
+    {
+      event = queue.pool.size();
+      queue.pool.push_back(simEvent());
+    }
+  else
+    {
+      event = queue.freeEvents.back();
+      queue.freeEvents.pop_back();
+    }
+  queue.pool[event].time = time;
+  queue.pool[event].sequence = queue.sequence++;
+  queue.pool[event].type = type;
+  queue.pool[event].request = request;
+
+  // sift up
+  int i = queue.heap.size();
+  queue.heap.push_back(event);
+  while (i > 0 && eventBefore(queue, event, queue.heap[(i - 1) / 2]))
+    {
+      queue.heap[i] = queue.heap[(i - 1) / 2];
+      i = (i - 1) / 2;
+    }
+  queue.heap[i] = event;
+}
+
+/***************************************************************************
+ * simEvent popEvent(eventQueue &)
+ * Date: 17 October 2026
+ * Description: takes the earliest event off the queue and returns its pool
+ *entry to the free list.
+ *
+ * Parameters:
+ * queue I/O eventQueue&  queue to take from, must not be empty
+ * popEvent O/P simEvent  the earliest event
+ **************************************************************************/
+simEvent popEvent(eventQueue &queue)
+{
+  int top = queue.heap[0];
+  int moved = queue.heap.back();
+  int size = queue.heap.size() - 1;
+  int i = 0;
+
+  queue.heap.pop_back();
+
+  // sift the last event down from the top
+  while (size > 0)
+    {
+      int child = 2 * i + 1;
+      if (child >= size)
+	break;
+      if (child + 1 < size && eventBefore(queue, queue.heap[child + 1], queue.heap[child]))
+	child++;
+      if (!eventBefore(queue, queue.heap[child], moved))
+	break;
+      queue.heap[i] = queue.heap[child];
+      i = child;
+    }
+  if (size > 0)
+    queue.heap[i] = moved;
+
+  queue.freeEvents.push_back(top);
+  return queue.pool[top];
+}
+
+/***************************************************************************
+ * void clearPending(pendingSet &, int, int)
+ * Date: 17 October 2026
+ * Description: empties a pending set for the given scheduler.
+ *
+ * Parameters:
+ * pending O/P pendingSet&  set to be emptied
+ * policy I/P int  scheduler choosing from the set (ONLINE_FIFO...)
+ * batch I/P int  requests per batch of ONLINE_NSTEP
+ **************************************************************************/
+void clearPending(pendingSet &pending, int policy, int batch)
+{
+  pending.pool.clear();
+  pending.freeRequests.clear();
+  pending.policy = policy;
+  pending.batch = (policy == ONLINE_NSTEP) ? batch : 0;
+  pending.first = -1;
+  pending.last = -1;
+  pending.head.assign(activeDisk.tracks, -1);
+  pending.tail.assign(activeDisk.tracks, -1);
+  pending.occupied.assign((activeDisk.tracks + 63) / 64, 0);
+  pending.count = 0;
+  pending.active = 0;
+  pending.up = true;
+}
+
+/***************************************************************************
+ * int newRequest(pendingSet &, double, int, int)
+ * Date: 17 October 2026
+ * Description: takes a request from the pool for an arrival that has been
+ *scheduled but not happened yet. It joins the set with addPending().
+ *
+ * Parameters:
+ * pending I/O pendingSet&  set whose pool the request comes from
+ * arrival I/P double  arrival time in milliseconds
+ * track I/P int  requested track
+ * sector I/P int  requested sector
+ * newRequest O/P int  pool index of the request
+ **************************************************************************/
+int newRequest(pendingSet &pending, double arrival, int track, int sector)
+{
+  int request;
+
+  if (pending.freeRequests.empty())
+    {
+      request = pending.pool.size();
+      pending.pool.push_back(simRequest());
+    }
+  else
+    {
+      request = pending.freeRequests.back();
+      pending.freeRequests.pop_back();
+    }
+  pending.pool[request].arrival = arrival;
+  pending.pool[request].track = track;
+  pending.pool[request].sector = sector;
+  pending.pool[request].next = -1;
+  return request;
+}
+
+/***************************************************************************
+ * void addToTrack(pendingSet &, int)
+ * Date: 17 October 2026
+ * Description: appends a request to the list of its track.
+ *
+ * Parameters:
+ * pending I/O pendingSet&  set the request is added to
+ * request I/P int  pool index of the request
+ **************************************************************************/
+void addToTrack(pendingSet &pending, int request)
+{
+  int track = pending.pool[request].track;
+
+  pending.pool[request].next = -1;
+  if (pending.tail[track] >= 0)
+    pending.pool[pending.tail[track]].next = request;
+  else
+    pending.head[track] = request;
+  pending.tail[track] = request;
+  pending.occupied[track >> 6] |= (uint64_t)1 << (track & 63);
+  pending.active++;
+}
+
+/***************************************************************************
+ * void addPending(pendingSet &, int)
+ * Date: 17 October 2026
+ * Description: adds a request that has just arrived to the set.
+ *
+ * Parameters:
+ * pending I/O pendingSet&  set the request is added to
+ * request I/P int  pool index of the request (from newRequest)
+ **************************************************************************/
+void addPending(pendingSet &pending, int request)
+{
+  if (pending.policy == ONLINE_FIFO || pending.policy == ONLINE_FSCAN || pending.policy == ONLINE_NSTEP)
+    {
+      if (pending.last >= 0)
+	pending.pool[pending.last].next = request;
+      else
+	pending.first = request;
+      pending.last = request;
+    }
+  else
+    {
+      addToTrack(pending, request);
+    }
+  pending.count++;
+}
+
+/***************************************************************************
+ * int trackAtOrAbove(const pendingSet &, int)
+ * Date: 17 October 2026
+ * Description: lowest track at or above track that has pending requests.
+ *
+ * Parameters:
+ * pending I/P const pendingSet&  set to search
+ * track I/P int  track to search from
+ * trackAtOrAbove O/P int  the track, -1 if there is none
+ **************************************************************************/
+int trackAtOrAbove(const pendingSet &pending, int track)
+{
+  const int words = pending.occupied.size();
+  int word = track >> 6;
+
+  if (track >= activeDisk.tracks)
+    return -1;
+
+  uint64_t bits = pending.occupied[word] & (~(uint64_t)0 << (track & 63));
+  while (bits == 0)
+    {
+      if (++word == words)
+	return -1;
+      bits = pending.occupied[word];
+    }
+  return word * 64 + __builtin_ctzll(bits);
+}
+
+/***************************************************************************
+ * int trackAtOrBelow(const pendingSet &, int)
+ * Date: 17 October 2026
+ * Description: highest track at or below track that has pending requests.
+ *
+ * Parameters:
+ * pending I/P const pendingSet&  set to search
+ * track I/P int  track to search from
+ * trackAtOrBelow O/P int  the track, -1 if there is none
+ **************************************************************************/
+int trackAtOrBelow(const pendingSet &pending, int track)
+{
+  int word = track >> 6;
+
+  if (track < 0)
+    return -1;
+
+  uint64_t bits = pending.occupied[word] & (~(uint64_t)0 >> (63 - (track & 63)));
+  while (bits == 0)
+    {
+      if (--word < 0)
+	return -1;
+      bits = pending.occupied[word];
+    }
+  return word * 64 + 63 - __builtin_clzll(bits);
+}
+
+/***************************************************************************
+ * void takeFromTrack(pendingSet &, int, int, int)
+ * Date: 17 October 2026
+ * Description: unlinks a request from the list of its track.
+ *
+ * Parameters:
+ * pending I/O pendingSet&  set the request is taken from
+ * track I/P int  track of the request
+ * request I/P int  pool index of the request
+ * before I/P int  request before it in the track's list, -1 if it is the oldest
+ **************************************************************************/
+void takeFromTrack(pendingSet &pending, int track, int request, int before)
+{
+  int after = pending.pool[request].next;
+
+  if (before >= 0)
+    pending.pool[before].next = after;
+  else
+    pending.head[track] = after;
+  if (after < 0)
+    pending.tail[track] = before;
+  if (pending.head[track] < 0)
+    pending.occupied[track >> 6] &= ~((uint64_t)1 << (track & 63));
+  pending.active--;
+}
+
+/***************************************************************************
+ * int takeSatf(pendingSet &, int, double)
+ * Date: 17 October 2026
+ * Description: removes and returns the request with the smallest seek plus
+ *rotational latency from the head. Tracks are tried outwards from the head
+ *and the search stops as soon as the seek alone rules out every track
+ *further out, as in satf(). Ties go to the lower track, then the older
+ *request.
+ *
+ * Parameters:
+ * pending I/O pendingSet&  set to take from, must not be empty
+ * currentTrack I/P int  track the head is on
+ * currentSector I/P double  sector the head is on
+ * takeSatf O/P int  pool index of the request
+ **************************************************************************/
+int takeSatf(pendingSet &pending, int currentTrack, double currentSector)
+{
+  double best = HUGE_VAL; // smallest access time found
+  int bestTrack = activeDisk.tracks, bestRequest = -1, bestBefore = -1;
+  double seek, rotation;
+
+  // tries every request on a track against the best so far
+  auto tryTrack = [&](int track) {
+    for (int request = pending.head[track], before = -1; request >= 0; before = request, request = pending.pool[request].next)
+      {
+	stepCost(currentTrack, currentSector, track, pending.pool[request].sector, seek, rotation);
+	if (seek + rotation < best || (seek + rotation == best && track < bestTrack))
+	  {
+	    best = seek + rotation;
+	    bestTrack = track;
+	    bestRequest = request;
+	    bestBefore = before;
+	  }
+      }
+  };
+
+  // upwards, until the seek alone is worse than the best
+  for (int track = trackAtOrAbove(pending, currentTrack); track >= 0; track = trackAtOrAbove(pending, track + 1))
+    {
+      if (min(seekTime(track - currentTrack), activeDisk.snapbackMs + seekTime(track)) > best)
+	break;
+      tryTrack(track);
+    }
+
+  // downwards, until the smallest seek possible from here on is worse than the best
+  for (int track = trackAtOrBelow(pending, currentTrack - 1); track >= 0; track = trackAtOrBelow(pending, track - 1))
+    {
+      if (min(seekTime(currentTrack - track), activeDisk.snapbackMs) > best)
+	break;
+      tryTrack(track);
+    }
+
+  takeFromTrack(pending, bestTrack, bestRequest, bestBefore);
+  return bestRequest;
+}
+
+/***************************************************************************
+ * int takePending(pendingSet &, int, double, int[])
+ * Date: 17 October 2026
+ * Description: removes and returns the request the scheduler services next,
+ *given where the head is. fifo takes the oldest request; sstf the closest
+ *track (the lower one on a tie, as sstf() does); look keeps going in one
+ *direction while there are requests that way and then turns around; clook
+ *only goes up and jumps back to the lowest track when there is nothing
+ *above; scan and cscan do the same but run on to the end of the disk
+ *before turning or jumping back, and list the edge tracks the head goes
+ *through first in edge. fscan and nstep sweep like scan over a frozen
+ *batch: when the per track lists run dry, every waiting request (fscan)
+ *or the oldest batch of them (nstep) is moved in, and anything arriving
+ *later waits for the next batch. satf is takeSatf(). On a track the oldest
+ *request goes first. The pool entry stays valid until releasePending().
+ *
+ * Parameters:
+ * pending I/O pendingSet&  set to take from, must not be empty
+ * currentTrack I/P int  track the head is on
+ * currentSector I/P double  sector the head is on
+ * edge O/P int[2]  edge tracks to go through before the request, -1 after the last
+ * takePending O/P int  pool index of the request
+ **************************************************************************/
+int takePending(pendingSet &pending, int currentTrack, double currentSector, int edge[])
+{
+  int request, track;
+  bool edges = (pending.policy == ONLINE_SCAN || pending.policy == ONLINE_CSCAN || pending.policy == ONLINE_FSCAN
+		|| pending.policy == ONLINE_NSTEP);
+
+  edge[0] = edge[1] = -1;
+  pending.count--;
+  if (pending.policy == ONLINE_FIFO)
+    {
+      request = pending.first;
+      pending.first = pending.pool[request].next;
+      if (pending.first < 0)
+	pending.last = -1;
+      return request;
+    }
+
+  // start the next batch once the last one is done
+  if ((pending.policy == ONLINE_FSCAN || pending.policy == ONLINE_NSTEP) && pending.active == 0)
+    {
+      for (int moved = 0; pending.first >= 0 && (pending.batch <= 0 || moved < pending.batch); moved++)
+	{
+	  request = pending.first;
+	  pending.first = pending.pool[request].next;
+	  addToTrack(pending, request);
+	}
+      if (pending.first < 0)
+	pending.last = -1;
+    }
+
+  if (pending.policy == ONLINE_SATF)
+    return takeSatf(pending, currentTrack, currentSector);
+
+  int above = trackAtOrAbove(pending, currentTrack);
+  int below = trackAtOrBelow(pending, currentTrack - 1);
+
+  if (pending.policy == ONLINE_SSTF)
+    {
+      track = (below >= 0 && (above < 0 || currentTrack - below <= above - currentTrack)) ? below : above;
+    }
+  else if (pending.policy == ONLINE_CLOOK || pending.policy == ONLINE_CSCAN)
+    {
+      track = (above >= 0) ? above : trackAtOrAbove(pending, 0);
+      if (above < 0 && edges)
+	{
+	  edge[0] = activeDisk.tracks - 1;
+	  edge[1] = 0;
+	}
+    }
+  else // ONLINE_LOOK, ONLINE_SCAN, ONLINE_FSCAN and ONLINE_NSTEP
+    {
+      if (pending.up && above < 0)
+	{
+	  pending.up = false;
+	  if (edges)
+	    edge[0] = activeDisk.tracks - 1;
+	}
+      else if (!pending.up && below < 0 && above != currentTrack)
+	{
+	  pending.up = true;
+	  if (edges)
+	    edge[0] = 0;
+	}
+      track = pending.up ? above : (above == currentTrack ? above : below);
+    }
+
+  request = pending.head[track];
+  takeFromTrack(pending, track, request, -1);
+  return request;
+}
+
+/***************************************************************************
+ * void releasePending(pendingSet &, int)
+ * Date: 17 October 2026
+ * Description: returns a serviced request's pool entry to the free list.
+ *
+ * Parameters:
+ * pending I/O pendingSet&  set the request came from
+ * request I/P int  pool index of the request
+ **************************************************************************/
+void releasePending(pendingSet &pending, int request)
+{
+  pending.freeRequests.push_back(request);
+}
+
+/***************************************************************************
+ * void advanceClock(const simulationOptions &, rngStream &, double &, double &)
+ * Date: 17 October 2026
+ * Description: moves the clock on to the next random arrival. poisson
+ *arrivals are exponentially spaced at opts.rate requests per millisecond.
+ *onoff arrivals are poisson during ON periods and stop during OFF periods
+ *(both exponentially long, averaging opts.onMs and opts.offMs), with the ON
+ *rate raised so the long run rate is still opts.rate.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  arrival process and its parameters
+ * rng I/O rngStream&  stream the gaps are drawn from
+ * clock I/O double&  time of the previous arrival, set to this one
+ * onUntil I/O double&  end of the current ON period (onoff only)
+ **************************************************************************/
+void advanceClock(const simulationOptions &opts, rngStream &rng, double &clock, double &onUntil)
+{
+  if (opts.arrival == ARRIVAL_ONOFF)
+    {
+      double onRate = opts.rate * (opts.onMs + opts.offMs) / opts.onMs;
+      double gap = -log(uniformReal(rng)) / onRate;
+
+      // skip OFF periods until the arrival lands in an ON period
+      while (clock + gap > onUntil)
+	{
+	  gap -= onUntil - clock;
+	  clock = onUntil - log(uniformReal(rng)) * opts.offMs;
+	  onUntil = clock - log(uniformReal(rng)) * opts.onMs;
+	}
+      clock += gap;
+    }
+  else // ARRIVAL_POISSON
+    {
+      clock += -log(uniformReal(rng)) / opts.rate;
+    }
+}
+
+/***************************************************************************
+ * bool nextArrival(const simulationOptions &, rngStream &, traceReader &, double &, double &, point &)
+ * Date: 17 October 2026
+ * Description: works out when the next request arrives and where it goes.
+ *Random arrivals are timed by advanceClock() and go to a uniform random
+ *track and sector. trace arrivals take their time and place from the trace.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  arrival process and its parameters
+ * rng I/O rngStream&  stream random arrivals are drawn from
+ * reader I/O traceReader&  open trace for trace arrivals
+ * clock I/O double&  time of the previous arrival, set to this one
+ * onUntil I/O double&  end of the current ON period (onoff only)
+ * where O/P point&  requested track and sector
+ * nextArrival O/P bool  false if there are no more arrivals (end of trace)
+ **************************************************************************/
+bool nextArrival(const simulationOptions &opts, rngStream &rng, traceReader &reader, double &clock, double &onUntil, point &where)
+{
+  if (opts.arrival == ARRIVAL_TRACE)
+    {
+      traceRecord record;
+
+      if (!nextTraceRecord(reader, record))
+	return false;
+      clock = max(clock, (record.time - reader.firstTime) * 1000); // seconds to milliseconds
+      where = tracePoint(record, opts.lbasPerSector);
+      return true;
+    }
+
+  advanceClock(opts, rng, clock, onUntil);
+  where = randomPoint(rng);
+  return true;
+}
+
+/***************************************************************************
+ * bool simulateOnline(const simulationOptions &, int, latencyHistogram &, onlineStats &)
+ * Date: 17 October 2026
+ * Description: discrete event simulation of one scheduler with requests
+ *arriving over time. Arrivals and completions are events in a priority
+ *queue; whenever the disk finishes a request the scheduler picks the next
+ *one from the requests pending at that moment. Service times come from
+ *stepCost(), and every request's response time (completion - arrival) is
+ *recorded in histogram. Every scheduler sees the same arrivals for the
+ *same seed.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  arrival process and number of requests
+ * policy I/P int  scheduler choosing the next request (ONLINE_FIFO...)
+ * histogram O/P latencyHistogram&  response times
+ * stats O/P onlineStats&  totals of the run
+ * simulateOnline O/P bool  false if the trace could not be read
+ **************************************************************************/
+bool simulateOnline(const simulationOptions &opts, int policy, latencyHistogram &histogram, onlineStats &stats)
+{
+  eventQueue events; // pools only grow to the most events / requests outstanding at once
+  pendingSet pending;
+  traceReader reader;
+  rngStream rng;
+  double clock = 0, onUntil = opts.onMs, lastEvent = 0;
+  double currentTrack = activeDisk.startTrack, currentSector = 0; // start in the middle of the track
+  bool busy = false;
+  point where;
+
+  if (opts.arrival == ARRIVAL_TRACE && !openTrace(reader, opts.trace, opts.traceFormat))
+    return false;
+
+  seedStream(rng, opts.seed, 0, 0);
+  events.sequence = 0;
+  clearPending(pending, policy, opts.nstep);
+  clearHistogram(histogram);
+  memset(&stats, 0, sizeof(stats));
+
+  long arrivals = 0;
+  if (nextArrival(opts, rng, reader, clock, onUntil, where))
+    {
+      scheduleEvent(events, clock, EVENT_ARRIVAL, newRequest(pending, clock, where.track, where.sector));
+      arrivals++;
+    }
+
+  while (!events.heap.empty())
+    {
+      simEvent event = popEvent(events);
+
+      stats.queueArea += pending.count * (event.time - lastEvent); // for the time average queue depth
+      lastEvent = event.time;
+      stats.events++;
+
+      if (event.type == EVENT_ARRIVAL)
+	{
+	  addPending(pending, event.request);
+
+	  // line up the next arrival
+	  if (arrivals < opts.simulate && nextArrival(opts, rng, reader, clock, onUntil, where))
+	    {
+	      scheduleEvent(events, clock, EVENT_ARRIVAL, newRequest(pending, clock, where.track, where.sector));
+	      arrivals++;
+	    }
+	}
+      else // EVENT_COMPLETION
+	{
+	  simRequest &done = pending.pool[event.request];
+	  recordLatency(histogram, event.time - done.arrival);
+	  releasePending(pending, event.request);
+	  busy = false;
+	}
+
+      // start the next request if the disk is free
+      if (!busy && pending.count > 0)
+	{
+	  int edge[2];
+	  int request = takePending(pending, (int)currentTrack, currentSector, edge);
+	  double serviceTime = 0;
+
+	  // scan and cscan may run on to the end of the disk first
+	  for (int e = 0; e < 2 && edge[e] >= 0; e++)
+	    {
+	      serviceStep(currentTrack, currentSector, edge[e], edgeSector(currentTrack, currentSector, edge[e]), serviceTime);
+	    }
+	  serviceStep(currentTrack, currentSector, pending.pool[request].track, pending.pool[request].sector, serviceTime);
+	  stats.busyTime += serviceTime;
+	  scheduleEvent(events, event.time + serviceTime, EVENT_COMPLETION, request);
+	  busy = true;
+	}
+    }
+
+  if (opts.arrival == ARRIVAL_TRACE)
+    closeTrace(reader);
+  stats.requests = histogram.total;
+  stats.endTime = lastEvent;
+  return true;
+}
+
+/***************************************************************************
+ * int runOnline(const simulationOptions &)
+ * Date: 17 October 2026
+ * Description: runs simulateOnline() for every selected scheduler (on its
+ *own thread when there are threads to spare) and prints the response time
+ *distribution, utilisation and average queue depth of each.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  arrival process and number of requests
+ * runOnline O/P int  status code, 1 if the trace could not be read
+ **************************************************************************/
+int runOnline(const simulationOptions &opts)
+{
+  int count = opts.schedulers.size();
+  unique_ptr<latencyHistogram[]> histogram(new latencyHistogram[count]);
+  vector<onlineStats> stats(count);
+  unique_ptr<bool[]> ok(new bool[count]);
+  vector<thread> workers;
+
+  auto start = chrono::steady_clock::now();
+
+  for (int alg = 0; alg < count; alg++)
+    {
+      auto run = [&opts, &histogram, &stats, &ok](int alg) {
+	ok[alg] = simulateOnline(opts, opts.schedulers[alg]->online, histogram[alg], stats[alg]);
+      };
+
+      if (opts.threads > 1)
+	workers.push_back(thread(run, alg));
+      else
+	run(alg);
+    }
+  for (size_t i = 0; i < workers.size(); i++)
+    {
+      workers[i].join();
+    }
+
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+  for (int alg = 0; alg < count; alg++)
+    {
+      if (!ok[alg])
+	{
+	  cerr << "could not read trace " << opts.trace << "\n";
+	  return 1;
+	}
+    }
+
+  uint64_t events = 0;
+  cout << "Response times in milliseconds\n";
+  outputPercentiles(cout, histogram.get(), 1, opts.schedulers);
+  cout << "Scheduler\tBusy\t\tQueue\n";
+  for (int alg = 0; alg < count; alg++)
+    {
+      double endTime = max(stats[alg].endTime, 1e-9);
+
+      cout << opts.schedulers[alg]->label << "\t\t" << (stats[alg].busyTime / endTime) << "\t\t"
+	   << (stats[alg].queueArea / endTime) << "\n";
+      events += stats[alg].events;
+    }
+  cout << events << " events in " << elapsed.count() << " s (" << (events / elapsed.count()) << " events/sec)\n";
+  return 0;
+}
+
+/***************************************************************************
+ * void resetRing(handoffRing &)
+ * Date: 17 October 2026
+ * Description: empties a ring and opens it again, before any thread uses it.
+ *
+ * Parameters:
+ * ring O/P handoffRing&  ring to be emptied
+ **************************************************************************/
+void resetRing(handoffRing &ring)
+{
+  ring.head.store(0, memory_order_relaxed);
+  ring.tail.store(0, memory_order_relaxed);
+  ring.closed.store(false, memory_order_relaxed);
+}
+
+/***************************************************************************
+ * bool pushRing(handoffRing &, const memberRequest &)
+ * Date: 17 October 2026
+ * Description: adds a request to the ring, from its producer thread only.
+ *
+ * Parameters:
+ * ring I/O handoffRing&  ring pushed to
+ * request I/P const memberRequest&  request to be pushed
+ * pushRing O/P bool  false if the ring is full
+ **************************************************************************/
+bool pushRing(handoffRing &ring, const memberRequest &request)
+{
+  uint64_t tail = ring.tail.load(memory_order_relaxed);
+
+  if (tail - ring.head.load(memory_order_acquire) == (uint64_t)HANDOFF_SLOTS)
+    return false;
+  ring.slots[tail % HANDOFF_SLOTS] = request;
+  ring.tail.store(tail + 1, memory_order_release); // publishes the slot
+  return true;
+}
+
+/***************************************************************************
+ * bool popRing(handoffRing &, memberRequest &)
+ * Date: 17 October 2026
+ * Description: takes the oldest request off the ring, from its consumer
+ *thread only.
+ *
+ * Parameters:
+ * ring I/O handoffRing&  ring popped from
+ * request O/P memberRequest&  request popped
+ * popRing O/P bool  false if the ring is empty
+ **************************************************************************/
+bool popRing(handoffRing &ring, memberRequest &request)
+{
+  uint64_t head = ring.head.load(memory_order_relaxed);
+
+  if (head == ring.tail.load(memory_order_acquire))
+    return false;
+  request = ring.slots[head % HANDOFF_SLOTS];
+  ring.head.store(head + 1, memory_order_release); // hands the slot back
+  return true;
+}
+
+/***************************************************************************
+ * int dataDisks(const simulationOptions &)
+ * Date: 17 October 2026
+ * Description: number of stripe units of data in each row of the array:
+ *every disk for raid 0, one for raid 1 (every disk is a copy), one per
+ *mirrored pair for raid 10 and all but the parity disk for raid 5.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  raid level and number of disks
+ * dataDisks O/P int  data units per row
+ **************************************************************************/
+int dataDisks(const simulationOptions &opts)
+{
+  if (opts.raid == 1)
+    return 1;
+  if (opts.raid == 10)
+    return opts.disks / 2;
+  if (opts.raid == 5)
+    return opts.disks - 1;
+  return opts.disks;
+}
+
+/***************************************************************************
+ * int64_t arrayCapacity(const simulationOptions &)
+ * Date: 17 October 2026
+ * Description: sectors of logical space the array holds, whole rows of
+ *stripe units of activeDisk.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  raid level, number of disks and stripe unit
+ * arrayCapacity O/P int64_t  logical sectors
+ **************************************************************************/
+int64_t arrayCapacity(const simulationOptions &opts)
+{
+  return (int64_t)dataDisks(opts) * (activeDisk.addresses / opts.stripeUnit) * opts.stripeUnit;
+}
+
+/***************************************************************************
+ * void splitRequest(const simulationOptions &, uint64_t, int64_t, int, bool, vector<int> &, vector<memberRequest> &)
+ * Date: 17 October 2026
+ * Description: splits a logical request into the member requests of the
+ *spindles. Logical space is cut into stripe units laid out a row at a
+ *time across the data disks. raid 0 puts unit u on disk u % disks. raid 1
+ *and raid 10 write every copy and read one, taking turns by request
+ *number. raid 5 rotates parity left symmetrically (the parity of row r is
+ *on disk disks - 1 - r % disks and data starts on the disk after it); a
+ *write that covers a whole row writes its data and parity, any other
+ *write reads and rewrites the data it touches and the parity under it
+ *(read-modify-write). Pieces that land next to each other on the same
+ *disk are merged into one member.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  array layout
+ * logical I/P uint64_t  number of the logical request
+ * address I/P int64_t  first logical sector
+ * length I/P int  logical sectors, address + length at most arrayCapacity()
+ * write I/P bool  the request is a write
+ * disk O/P vector<int>&  spindle of each member
+ * members O/P vector<memberRequest>&  the members (address, length and rewrite set)
+ **************************************************************************/
+void splitRequest(const simulationOptions &opts, uint64_t logical, int64_t address, int length, bool write,
+		  vector<int> &disk, vector<memberRequest> &members)
+{
+  const int unit = opts.stripeUnit;
+  const int data = dataDisks(opts);
+  const int64_t end = address + length;
+  int64_t parityRow = -1; // raid 5 row whose parity is still to be added
+  int parityFirst = 0, parityEnd = 0; // offsets of that row's parity touched
+  bool fullRow = false; // that row is written whole
+
+  auto addPiece = [&](int d, int64_t at, int count, bool rewrite) {
+    for (size_t m = 0; m < members.size(); m++)
+      {
+	if (disk[m] == d && members[m].address + members[m].length == at && members[m].rewrite == rewrite)
+	  {
+	    members[m].length += count;
+	    return;
+	  }
+      }
+    memberRequest member = memberRequest();
+    member.logical = logical;
+    member.address = at;
+    member.length = count;
+    member.rewrite = rewrite;
+    disk.push_back(d);
+    members.push_back(member);
+  };
+  auto addParity = [&]() {
+    if (parityRow >= 0)
+      addPiece((opts.disks - 1) - parityRow % opts.disks, parityRow * unit + parityFirst, parityEnd - parityFirst, !fullRow);
+  };
+
+  disk.clear();
+  members.clear();
+  for (int64_t at = address; at < end;)
+    {
+      int64_t stripe = at / unit;
+      int offset = at % unit;
+      int count = (int)min<int64_t>(unit - offset, end - at);
+      int64_t row = stripe / data;
+      int column = stripe % data;
+      int64_t diskAddress = row * unit + offset;
+
+      if (opts.raid == 1 || opts.raid == 10)
+	{
+	  int copies = (opts.raid == 1) ? opts.disks : 2;
+	  int first = (opts.raid == 1) ? 0 : column * 2;
+
+	  if (write)
+	    {
+	      for (int c = 0; c < copies; c++)
+		addPiece(first + c, diskAddress, count, false);
+	    }
+	  else
+	    addPiece(first + logical % copies, diskAddress, count, false);
+	}
+      else if (opts.raid == 5)
+	{
+	  int parity = (opts.disks - 1) - row % opts.disks;
+	  int d = (parity + 1 + column) % opts.disks;
+
+	  if (write && row != parityRow)
+	    {
+	      addParity();
+	      parityRow = row;
+	      parityFirst = offset;
+	      parityEnd = offset + count;
+	      fullRow = (address <= row * data * unit && end >= (row + 1) * data * unit);
+	    }
+	  else if (write)
+	    {
+	      parityFirst = min(parityFirst, offset);
+	      parityEnd = max(parityEnd, offset + count);
+	    }
+	  addPiece(d, diskAddress, count, write && !fullRow);
+	}
+      else // raid 0
+	addPiece(column, diskAddress, count, false);
+
+      at += count;
+    }
+  addParity();
+}
+
+/***************************************************************************
+ * bool nextLogicalArrival(const simulationOptions &, rngStream &, traceReader &, double &, double &, int64_t &, int &, bool &)
+ * Date: 17 October 2026
+ * Description: works out when the next logical request of an array arrives
+ *and what it asks for. Random requests are timed by advanceClock(), are
+ *opts.requestSectors long, start at a uniform random logical sector and
+ *are writes opts.writeFraction of the time. trace requests take their
+ *time, place, length and direction from the trace, wrapped around the
+ *logical space.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  arrival process, request length and write share
+ * rng I/O rngStream&  stream random requests are drawn from
+ * reader I/O traceReader&  open trace for trace arrivals
+ * clock I/O double&  time of the previous arrival, set to this one
+ * onUntil I/O double&  end of the current ON period (onoff only)
+ * address O/P int64_t&  first logical sector
+ * length O/P int&  logical sectors
+ * write O/P bool&  the request is a write
+ * nextLogicalArrival O/P bool  false if there are no more arrivals (end of trace)
+ **************************************************************************/
+bool nextLogicalArrival(const simulationOptions &opts, rngStream &rng, traceReader &reader, double &clock, double &onUntil,
+			int64_t &address, int &length, bool &write)
+{
+  int64_t capacity = arrayCapacity(opts);
+
+  if (opts.arrival == ARRIVAL_TRACE)
+    {
+      traceRecord record;
+
+      if (!nextTraceRecord(reader, record))
+	return false;
+      clock = max(clock, (record.time - reader.firstTime) * 1000); // seconds to milliseconds
+      length = (int)min<uint64_t>(max<uint64_t>(1, record.length / opts.lbasPerSector), min<int64_t>(capacity, INT_MAX));
+      address = min<int64_t>((record.lba / opts.lbasPerSector) % capacity, capacity - length);
+      write = record.write;
+      return true;
+    }
+
+  advanceClock(opts, rng, clock, onUntil);
+  length = (int)min<int64_t>(opts.requestSectors, capacity);
+  address = min<int64_t>((int64_t)(uniformReal(rng) * (capacity - length + 1)), capacity - length);
+  write = (uniformReal(rng) <= opts.writeFraction);
+  return true;
+}
+
+/***************************************************************************
+ * void spindleWorker(arrayState &, int)
+ * Date: 17 October 2026
+ * Description: simulates one spindle of an array on its own thread. Member
+ *requests come in through the spindle's ring in arrival order and the
+ *spindle runs the same event loop as simulateOnline() on its own pending
+ *set: with one request in service and arrivals already in time order the
+ *next event is either that completion or the next arrival (the completion
+ *first on a tie), so it waits for the next arrival to be known (or the
+ *ring to be closed) before handling anything. The first sector of a
+ *member is read as the head reaches it, as in the single disk model, and
+ *every further sector takes one sector time; a rewrite adds one rotation.
+ *Completed members go back through the spindle's other ring. Spindles do
+ *not depend on each other, so each one's results are the same however the
+ *threads run.
+ *
+ * Parameters:
+ * state I/O arrayState&  shared array state
+ * disk I/P int  spindle simulated
+ **************************************************************************/
+void spindleWorker(arrayState &state, int disk)
+{
+  handoffRing &in = state.toSpindle[disk];
+  handoffRing &out = state.fromSpindle[disk];
+  latencyHistogram &histogram = state.memberHistogram[disk];
+  onlineStats &stats = state.spindleStats[disk];
+  pendingSet pending;
+  vector<memberRequest> member; // member request of each pool entry
+  memberRequest next; // next arrival, once haveNext
+  bool haveNext = false, closed = false;
+  int serving = -1; // pool index of the member being serviced, -1 if the disk is free
+  double completion = 0, lastEvent = 0;
+  double currentTrack = activeDisk.startTrack, currentSector = 0; // start in the middle of the track
+
+  clearPending(pending, state.policy, state.opts->nstep);
+  clearHistogram(histogram);
+  memset(&stats, 0, sizeof(stats));
+
+  for (;;)
+    {
+      if (!haveNext && !closed)
+	{
+	  if (popRing(in, next))
+	    haveNext = true;
+	  else if (in.closed.load(memory_order_acquire))
+	    {
+	      // anything pushed before the ring was closed is visible now
+	      haveNext = popRing(in, next);
+	      closed = !haveNext;
+	    }
+	  else
+	    {
+	      this_thread::yield();
+	      continue;
+	    }
+	}
+
+      double time;
+      if (serving >= 0 && (!haveNext || completion <= next.time))
+	{
+	  time = completion;
+	  stats.queueArea += pending.count * (time - lastEvent);
+	  lastEvent = time;
+
+	  memberRequest done = member[serving];
+	  recordLatency(histogram, time - done.time);
+	  done.time = time;
+	  while (!pushRing(out, done))
+	    this_thread::yield();
+	  releasePending(pending, serving);
+	  serving = -1;
+	}
+      else if (haveNext)
+	{
+	  time = next.time;
+	  stats.queueArea += pending.count * (time - lastEvent);
+	  lastEvent = time;
+
+	  point where = addressPoint(next.address);
+	  int request = newRequest(pending, next.time, where.track, where.sector);
+	  if ((size_t)request >= member.size())
+	    member.resize(request + 1);
+	  member[request] = next;
+	  addPending(pending, request);
+	  haveNext = false;
+	}
+      else // closed, and nothing left to do
+	break;
+      stats.events++;
+
+      // start the next member if the disk is free
+      if (serving < 0 && pending.count > 0)
+	{
+	  int edge[2];
+	  int request = takePending(pending, (int)currentTrack, currentSector, edge);
+	  const memberRequest &start = member[request];
+	  double track = pending.pool[request].track, serviceTime = 0;
+
+	  for (int e = 0; e < 2 && edge[e] >= 0; e++)
+	    {
+	      serviceStep(currentTrack, currentSector, edge[e], edgeSector(currentTrack, currentSector, edge[e]), serviceTime);
+	    }
+	  serviceStep(currentTrack, currentSector, track, pending.pool[request].sector, serviceTime);
+	  serviceTime += (start.length - 1) * activeDisk.sectorTime(track) + (start.rewrite ? activeDisk.rotationMs : 0);
+	  currentSector = fmod(currentSector + start.length - 1, activeDisk.sectorsOn(track));
+
+	  stats.busyTime += serviceTime;
+	  completion = time + serviceTime;
+	  serving = request;
+	}
+    }
+
+  stats.requests = histogram.total;
+  stats.endTime = lastEvent;
+  out.closed.store(true, memory_order_release);
+}
+
+/***************************************************************************
+ * bool simulateArray(const simulationOptions &, int, arrayState &, latencyHistogram &, onlineStats &)
+ * Date: 17 October 2026
+ * Description: event driven simulation of a raid array (--raid) with every
+ *spindle running the same scheduler. This thread is the coordinator: it
+ *draws the logical requests, splits them (splitRequest) and hands the
+ *members to the spindle workers, one thread per spindle, through lock free
+ *rings, never waiting on a full ring without taking in completions. A
+ *logical request is complete when its slowest member is; requests are
+ *retired in arrival order once all their members are back, so the array
+ *histogram comes out the same for any thread timing.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  array layout, arrival process and number of requests
+ * policy I/P int  scheduler every spindle runs (ONLINE_FIFO...)
+ * state O/P arrayState&  per spindle results
+ * histogram O/P latencyHistogram&  response times of the logical requests
+ * stats O/P onlineStats&  logical requests, events of every spindle and time of the last completion
+ * simulateArray O/P bool  false if the trace could not be read
+ **************************************************************************/
+bool simulateArray(const simulationOptions &opts, int policy, arrayState &state, latencyHistogram &histogram, onlineStats &stats)
+{
+  int disks = opts.disks;
+  traceReader reader;
+  rngStream rng;
+  double clock = 0, onUntil = opts.onMs;
+  vector<arrayRequest> window(1024); // requests not retired yet, request i in slot i % window.size()
+  uint64_t oldest = 0, arrivals = 0; // oldest request not retired, and requests so far
+  vector<int> disk;
+  vector<memberRequest> members;
+  vector<thread> workers;
+  int64_t address;
+  int length;
+  bool write;
+
+  if (opts.arrival == ARRIVAL_TRACE && !openTrace(reader, opts.trace, opts.traceFormat))
+    return false;
+
+  seedStream(rng, opts.seed, 0, 0);
+  clearHistogram(histogram);
+  memset(&stats, 0, sizeof(stats));
+  state.opts = &opts;
+  state.policy = policy;
+  state.toSpindle.reset(new handoffRing[disks]);
+  state.fromSpindle.reset(new handoffRing[disks]);
+  state.memberHistogram.resize(disks);
+  state.spindleStats.resize(disks);
+  state.slowest.assign(disks, 0);
+  for (int d = 0; d < disks; d++)
+    {
+      resetRing(state.toSpindle[d]);
+      resetRing(state.fromSpindle[d]);
+    }
+  for (int d = 0; d < disks; d++)
+    {
+      workers.push_back(thread(spindleWorker, ref(state), d));
+    }
+
+  // take in every completed member, then retire the requests that are done
+  auto collect = [&]() {
+    memberRequest done;
+
+    for (int d = 0; d < disks; d++)
+      {
+	while (popRing(state.fromSpindle[d], done))
+	  {
+	    arrayRequest &request = window[done.logical % window.size()];
+
+	    // the lowest spindle counts as the slowest on a tie, whatever order the rings are read in
+	    if (done.time > request.finish || (done.time == request.finish && d < request.slowest))
+	      {
+		request.finish = done.time;
+		request.slowest = d;
+	      }
+	    request.remaining--;
+	  }
+      }
+    while (oldest < arrivals && window[oldest % window.size()].remaining == 0)
+      {
+	const arrayRequest &request = window[oldest % window.size()];
+
+	recordLatency(histogram, request.finish - request.arrival);
+	state.slowest[request.slowest]++;
+	stats.endTime = max(stats.endTime, request.finish);
+	oldest++;
+      }
+  };
+
+  while ((long)arrivals < opts.simulate && nextLogicalArrival(opts, rng, reader, clock, onUntil, address, length, write))
+    {
+      splitRequest(opts, arrivals, address, length, write, disk, members);
+
+      if (arrivals - oldest == window.size())
+	{
+	  vector<arrayRequest> wider(window.size() * 2);
+
+	  for (uint64_t i = oldest; i < arrivals; i++)
+	    wider[i % wider.size()] = window[i % window.size()];
+	  window.swap(wider);
+	}
+      arrayRequest &request = window[arrivals % window.size()];
+      request.arrival = clock;
+      request.finish = -HUGE_VAL;
+      request.remaining = members.size();
+      request.slowest = disks;
+      arrivals++;
+
+      for (size_t m = 0; m < members.size(); m++)
+	{
+	  members[m].time = clock;
+	  while (!pushRing(state.toSpindle[disk[m]], members[m]))
+	    {
+	      collect();
+	      this_thread::yield();
+	    }
+	}
+      collect();
+    }
+
+  for (int d = 0; d < disks; d++)
+    {
+      state.toSpindle[d].closed.store(true, memory_order_release);
+    }
+  while (oldest < arrivals)
+    {
+      collect();
+      this_thread::yield();
+    }
+  for (size_t i = 0; i < workers.size(); i++)
+    {
+      workers[i].join();
+    }
+
+  if (opts.arrival == ARRIVAL_TRACE)
+    closeTrace(reader);
+  for (int d = 0; d < disks; d++)
+    {
+      stats.events += state.spindleStats[d].events;
+    }
+  stats.requests = histogram.total;
+  return true;
+}
+
+/***************************************************************************
+ * int runArray(const simulationOptions &)
+ * Date: 17 October 2026
+ * Description: runs simulateArray() for every selected scheduler in turn
+ *and prints the response times of the logical requests (the slowest
+ *member of each), the array throughput and members per request, and the
+ *utilisation, average queue depth, member p99 and how often it was the
+ *slowest member of every spindle.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  array layout, arrival process and number of requests
+ * runArray O/P int  status code, 1 if the trace could not be read
+ **************************************************************************/
+int runArray(const simulationOptions &opts)
+{
+  int count = opts.schedulers.size();
+  unique_ptr<latencyHistogram[]> histogram(new latencyHistogram[count]);
+  vector<onlineStats> stats(count);
+  vector<arrayState> states(count);
+
+  auto start = chrono::steady_clock::now();
+
+  for (int alg = 0; alg < count; alg++)
+    {
+      if (!simulateArray(opts, opts.schedulers[alg]->online, states[alg], histogram[alg], stats[alg]))
+	{
+	  cerr << "could not read trace " << opts.trace << "\n";
+	  return 1;
+	}
+    }
+
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+  uint64_t events = 0;
+  cout << "RAID " << opts.raid << " over " << opts.disks << " disks, " << opts.stripeUnit << " sector stripe unit\n"
+       << "Response times in milliseconds (slowest member of each request)\n";
+  outputPercentiles(cout, histogram.get(), 1, opts.schedulers);
+  cout << "Scheduler\tRequests/s\tMembers/request\n";
+  for (int alg = 0; alg < count; alg++)
+    {
+      uint64_t members = 0;
+
+      for (const onlineStats &spindle : states[alg].spindleStats)
+	members += spindle.requests;
+      cout << opts.schedulers[alg]->label << "\t\t" << (stats[alg].requests * 1000.0 / max(stats[alg].endTime, 1e-9)) << "\t\t"
+	   << ((double)members / max<uint64_t>(1, stats[alg].requests)) << "\n";
+      events += stats[alg].events;
+    }
+  cout << "Scheduler\tDisk\tBusy\t\tQueue\t\tMember p99\tSlowest\n";
+  for (int alg = 0; alg < count; alg++)
+    {
+      double endTime = max(stats[alg].endTime, 1e-9);
+
+      for (int d = 0; d < opts.disks; d++)
+	{
+	  const onlineStats &spindle = states[alg].spindleStats[d];
+
+	  cout << opts.schedulers[alg]->label << "\t\t" << d << "\t" << (spindle.busyTime / endTime) << "\t\t"
+	       << (spindle.queueArea / endTime) << "\t\t" << latencyPercentile(states[alg].memberHistogram[d], 99) << "\t\t"
+	       << (100.0 * states[alg].slowest[d] / max<uint64_t>(1, stats[alg].requests)) << "%\n";
+	}
+    }
+  cout << events << " events in " << elapsed.count() << " s (" << (events / elapsed.count()) << " events/sec)\n";
+  return 0;
+}
+
+/***************************************************************************
+ * struct sharedHeader
+ * Date: 17 October 2026
+ * Description: start of the memory mapped region a sweep run by several
+ *processes (--shared) is coordinated through. The process that creates the
+ *region fills it in and sets ready last; every other process waits for
+ *ready and checks key before it joins. Only lock free atomics are used,
+ *so they work the same between processes as between threads.
+ **************************************************************************/
+struct sharedHeader
+{
+  char magic[8]; // SHARED_MAGIC
+  char key[SHARED_KEY_BYTES]; // checkpointKey of the sweep, so only the same sweep joins
+  atomic<int> ready; // set once the region is filled in
+  int blocks; // number of experiment blocks
+  int tiles; // number of (block, size) tiles
+  int sizes; // number of request sizes
+  int schedulers; // number of schedulers run
+  int firstSize; // smallest request size
+  int experiments; // experiments per request size
+  int scheduler[NUM_SCHEDULERS]; // index in SCHEDULERS of each scheduler run, for --status
+  int64_t startNs; // system clock when the region was created, in nanoseconds
+  atomic<int> nextTile; // next tile never handed out
+  atomic<int> tilesDone; // tiles whose results are all in the region
+  atomic<int> damaged; // tiles whose process died while merging its histograms
+  atomic<int> finished; // set once the last tile is done
+  atomic<int64_t> endNs; // system clock when the last tile was done
+};
+
+/***************************************************************************
+ * struct sharedTile
+ * Date: 17 October 2026
+ * Description: which process runs a tile of a shared sweep and how far it
+ *got. A tile left RUNNING by a process that no longer exists is taken over
+ *and run again from the start by the next process out of fresh tiles.
+ **************************************************************************/
+struct sharedTile
+{
+  atomic<int32_t> owner; // pid of the process that runs or ran the tile, 0 if not handed out yet
+  atomic<int32_t> phase; // see tilePhase
+};
+
+/***************************************************************************
+ * struct sharedHistogram
+ * Date: 17 October 2026
+ * Description: a latencyHistogram of a shared sweep that any process can
+ *add a tile's histogram into at any time without a lock.
+ **************************************************************************/
+struct sharedHistogram
+{
+  atomic<uint64_t> counts[HISTOGRAM_BUCKETS]; // number of values in each bucket
+  atomic<uint64_t> total; // number of values recorded
+  atomic<double> sum; // sum of the values in milliseconds
+  atomic<double> max; // largest value in milliseconds
+};
+static_assert(atomic<int>::is_always_lock_free && atomic<uint64_t>::is_always_lock_free && atomic<double>::is_always_lock_free,
+	      "shared sweeps need lock free atomics, which are the only ones that work between processes");
+
+/***************************************************************************
+ * struct sharedSweep
+ * Date: 17 October 2026
+ * Description: one process's view of the region of a shared sweep (see
+ *mapShared for the layout). Each tile's summed seek times and running
+ *statistics are only written by the process running it, so they are
+ *merged in block order at the end and come out the same as in a sweep run
+ *by one process. The histogram counts are added atomically, whole numbers
+ *that come out the same in any order.
+ **************************************************************************/
+struct sharedSweep
+{
+  sharedHeader *header; // start of the region
+  size_t bytes; // size of the region
+  sharedTile *tile; // state of every tile [tile]
+  atomic<int> *blockRemaining; // tiles left before a block is complete [block]
+  double *seekTime; // summed average seek times [tile][scheduler]
+  runningStat *stat; // running statistics [tile][scheduler]
+  sharedHistogram *histogram; // service times [size][scheduler]
+  atomic<bool> finisher; // set in the process that completed the last tile
+};
+
+/***************************************************************************
+ * size_t layoutShared(sharedHeader &, sharedSweep *)
+ * Date: 17 October 2026
+ * Description: lays out the region of a shared sweep after its header:
+ *the tiles, the block counters, the seek times and running statistics of
+ *every tile and the histograms of every (size, scheduler) cell, each on a
+ *cache line boundary. Only the counts of header are read.
+ *
+ * Parameters:
+ * header I/P sharedHeader&  header at the start of the region, or one with just the counts filled in
+ * shared O/P sharedSweep*  view whose pointers are set into the region after header, or NULL
+ * layoutShared O/P size_t  size of the whole region in bytes
+ **************************************************************************/
+size_t layoutShared(sharedHeader &header, sharedSweep *shared)
+{
+  size_t cells = (size_t)header.tiles * header.schedulers;
+  size_t part[6] = { sizeof(sharedHeader), header.tiles * sizeof(sharedTile), header.blocks * sizeof(atomic<int>),
+		     cells * sizeof(double), cells * sizeof(runningStat),
+		     (size_t)header.sizes * header.schedulers * sizeof(sharedHistogram) };
+  size_t offset[6], bytes = 0;
+
+  for (int i = 0; i < 6; i++)
+    {
+      offset[i] = bytes;
+      bytes += (part[i] + 63) & ~(size_t)63;
+    }
+  if (shared != NULL)
+    {
+      char *base = (char *)&header;
+
+      shared->header = &header;
+      shared->bytes = bytes;
+      shared->tile = (sharedTile *)(base + offset[1]);
+      shared->blockRemaining = (atomic<int> *)(base + offset[2]);
+      shared->seekTime = (double *)(base + offset[3]);
+      shared->stat = (runningStat *)(base + offset[4]);
+      shared->histogram = (sharedHistogram *)(base + offset[5]);
+    }
+  return bytes;
+}
+
+/***************************************************************************
+ * void mergeShared(sharedHistogram &, const latencyHistogram &)
+ * Date: 17 October 2026
+ * Description: adds the values of from into a shared histogram without a
+ *lock. The sum and max are updated with compare and swap loops.
+ *
+ * Parameters:
+ * into I/O sharedHistogram&  histogram the values are added to
+ * from I/P const latencyHistogram&  histogram to be added
+ **************************************************************************/
+void mergeShared(sharedHistogram &into, const latencyHistogram &from)
+{
+  for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++)
+    {
+      if (from.counts[bucket] != 0)
+	into.counts[bucket].fetch_add(from.counts[bucket], memory_order_relaxed);
+    }
+  into.total.fetch_add(from.total, memory_order_relaxed);
+
+  double sum = into.sum.load();
+  while (!into.sum.compare_exchange_weak(sum, sum + from.sum))
+    ;
+  double most = into.max.load();
+  while (from.max > most && !into.max.compare_exchange_weak(most, from.max))
+    ;
+}
+
+/***************************************************************************
+ * void loadShared(latencyHistogram &, const sharedHistogram &)
+ * Date: 17 October 2026
+ * Description: copies a shared histogram into an ordinary one.
+ *
+ * Parameters:
+ * into O/P latencyHistogram&  histogram to be filled
+ * from I/P const sharedHistogram&  histogram to be copied
+ **************************************************************************/
+void loadShared(latencyHistogram &into, const sharedHistogram &from)
+{
+  for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++)
+    {
+      into.counts[bucket] = from.counts[bucket].load(memory_order_relaxed);
+    }
+  into.total = from.total.load();
+  into.sum = from.sum.load();
+  into.max = from.max.load();
+}
+
+/***************************************************************************
+ * int32_t processId()
+ * Date: 17 October 2026
+ * Description: id of the calling process, which owns the tiles it runs.
+ *
+ * Parameters:
+ * processId O/P int32_t  process id
+ **************************************************************************/
+int32_t processId()
+{
+#ifdef __linux__
+  return getpid();
+#else
+  return 1;
+#endif
+}
+
+/***************************************************************************
+ * bool processAlive(int32_t)
+ * Date: 17 October 2026
+ * Description: whether a process still exists, without disturbing it.
+ *Ids of 0 and below are never a process (kill() would take them as a
+ *process group and always succeed).
+ *
+ * Parameters:
+ * pid I/P int32_t  process id
+ * processAlive O/P bool  false only if there is no such process
+ **************************************************************************/
+bool processAlive(int32_t pid)
+{
+  if (pid <= 0)
+    return false;
+#ifdef __linux__
+  return kill(pid, 0) == 0 || errno != ESRCH;
+#else
+  return true;
+#endif
+}
+
+/***************************************************************************
+ * void finishTile(sharedSweep &, int)
+ * Date: 17 October 2026
+ * Description: marks a tile of a shared sweep done, once all its results
+ *are in the region. The process that completes the last tile is the one
+ *that writes the results of the sweep.
+ *
+ * Parameters:
+ * shared I/O sharedSweep&  region of the sweep
+ * tile I/P int  tile that is done
+ **************************************************************************/
+void finishTile(sharedSweep &shared, int tile)
+{
+  shared.tile[tile].phase.store(TILE_DONE);
+  if (shared.header->tilesDone.fetch_add(1) + 1 == shared.header->tiles)
+    {
+      shared.header->endNs = chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch()).count();
+      shared.header->finished.store(1);
+      shared.finisher = true;
+    }
+}
+
+/***************************************************************************
+ * int claimTile(sharedSweep &)
+ * Date: 17 October 2026
+ * Description: hands the calling process the next tile of a shared sweep.
+ *Tiles are first taken in order through the region's atomic counter, and
+ *a tile only belongs to a process once a compare and swap has set its
+ *owner from 0. Once they are all handed out, tiles left by processes that
+ *died are taken over the same way, so only one process gets each: a tile
+ *whose owner is 0 (its process died between the counter and the owner) or
+ *whose owner is gone is cleared and run again if it was waiting or
+ *running, and one that was merging its histograms is counted done and
+ *damaged, as part of its histograms may already be in (its seek times are
+ *complete).
+ *
+ * Parameters:
+ * shared I/O sharedSweep&  region of the sweep
+ * claimTile O/P int  tile to be run, the number of tiles if there is none
+ **************************************************************************/
+int claimTile(sharedSweep &shared)
+{
+  sharedHeader &header = *shared.header;
+  int32_t self = processId();
+  int tile;
+
+  while ((tile = header.nextTile.fetch_add(1)) < header.tiles)
+    {
+      int32_t none = 0;
+
+      // fails only if the tile was taken over after this process was handed it
+      if (shared.tile[tile].owner.compare_exchange_strong(none, self))
+	{
+	  shared.tile[tile].phase.store(TILE_RUNNING);
+	  return tile;
+	}
+    }
+
+  for (tile = 0; tile < header.tiles; tile++)
+    {
+      sharedTile &state = shared.tile[tile];
+      int32_t owner = state.owner.load();
+      int phase = state.phase.load();
+
+      if (phase == TILE_DONE || owner == self || (owner != 0 && processAlive(owner)) ||
+	  !state.owner.compare_exchange_strong(owner, self))
+	continue;
+
+      phase = state.phase.load(); // a dead owner cannot move it on, but it may have before it died
+      if (phase == TILE_WAITING || phase == TILE_RUNNING)
+	{
+	  double *cell = shared.seekTime + (size_t)tile * header.schedulers;
+	  runningStat *stat = shared.stat + (size_t)tile * header.schedulers;
+
+	  fill(cell, cell + header.schedulers, 0.0);
+	  fill(stat, stat + header.schedulers, runningStat());
+	  state.phase.store(TILE_RUNNING);
+	  return tile;
+	}
+      if (phase == TILE_MERGING)
+	{
+	  header.damaged.fetch_add(1);
+	  shared.blockRemaining[tile / header.sizes].fetch_sub(1);
+	  finishTile(shared, tile);
+	}
+    }
+  return header.tiles;
+}
+
+/***************************************************************************
+ * struct sweepState
+ * Date: 17 October 2026
+ * Description: state shared by the worker threads of one sweep. Work is
+ *handed out as tiles of (experiment block, request size) through an atomic
+ *counter. Every tile owns its own accumulator cell in blockSeekTime, so no
+ *two workers ever add into the same double, and the cells are merged in
+ *block order once all workers are done. That keeps the floating point sums
+ *identical no matter how many threads ran or which thread ran which tile.
+ *Service times go into one histogram per (size, scheduler); a tile merges
+ *its histograms in under the lock of its size's stripe. Bucket counts are
+ *whole numbers so they come out the same in any merge order.
+ *The adaptive sweep runs one round of tiles at a time through the same
+ *state, with only the cells still being sampled active.
+ *With --profile every worker times its phases in a phaseProfile of its
+ *own and adds it into profile (under outputLock) when it runs out of tiles.
+ *With --raw every tile writes its experiments to raw as soon as it is done,
+ *so raw rows come in the order tiles finish rather than a fixed order.
+ *With --shared the tiles are taken from, and their results kept in, the
+ *region shared with the other processes (see runShared) instead.
+ **************************************************************************/
+struct sweepState
+{
+  const simulationOptions *opts; // options the sweep was started with
+  int blocks; // number of experiment blocks
+  int tiles; // number of (block, size) tiles
+  vector<int> tileBlock; // experiment block of each tile
+  vector<int> tileSize; // request size of each tile
+  int experimentLimit; // experiments from this index on are not run
+  const uint8_t *active; // cells still being sampled [size][scheduler], NULL for all
+  atomic<int> nextTile; // next tile to be handed to a worker
+  int schedulers; // number of schedulers run
+  vector<double> blockSeekTime; // per tile accumulators [tile][scheduler]
+  vector<runningStat> blockStat; // per tile running statistics [tile][scheduler]
+  unique_ptr<atomic<int>[]> blockRemaining; // tiles left before a block is complete, NULL in the adaptive sweep
+  latencyHistogram *sizeHistogram; // service times [size][scheduler]
+  phaseProfile *profile; // phase times of every worker added up, NULL when not profiling
+  resultsSink *raw; // average seek time of every experiment, written as tiles finish, or NULL
+  sharedSweep *shared; // region the tiles are taken from and their results kept in with --shared, or NULL
+  mutex histogramLock[HISTOGRAM_LOCKS]; // stripe i guards the sizes equal to i modulo HISTOGRAM_LOCKS
+  mutex outputLock; // serializes progress output between workers
+};
+
+/***************************************************************************
+ * void runTile(sweepState &, int, workerArena &, latencyHistogram[], phaseProfile *, vector<double> &)
+ * Date: 17 October 2026
+ * Description: runs every experiment of one (experiment block, size) tile,
+ *adding the average seek times of each scheduler into the tile's cell and
+ *running statistics and the service time of every request into the
+ *histograms of its size. Schedulers whose cell is no longer active are
+ *skipped (NaN in the raw rows).
+ *Each experiment draws from its own stream seeded by (seed, experiment,
+ *size) so any single experiment can be rerun on its own.
+ *With --interleave W the experiments are run W at a time: their queues are
+ *generated into the arena's lanes, and every scheduler with a lane (see
+ *schedulerInfo) runs on all W at once through interleaveLanes, the others
+ *on one after the other. The results are added up in experiment order
+ *either way, so they are the same for any width.
+ *With --no-percentiles the schedulers record nothing and the tile has no
+ *histograms to merge.
+ *
+ * Parameters:
+ * state I/O sweepState&  shared sweep state holding the tile's accumulator
+ * tile I/P int  index of the tile to run
+ * arena I/O workerArena&  worker scratch buffers the request is generated, sorted and loaded in
+ * histogram I/O latencyHistogram[]  worker scratch histograms, one per scheduler
+ * profile I/O phaseProfile*  worker profile the phases are timed into, or NULL
+ * raw I/O vector<double>&  worker scratch rows for state.raw (experiment, size, average of each scheduler)
+ **************************************************************************/
+void runTile(sweepState &state, int tile, workerArena &arena, latencyHistogram histogram[], phaseProfile *profile,
+	     vector<double> &raw)
+{
+  point *request = arena.request.data();
+  uint32_t *order = arena.order.data();
+  int block = state.tileBlock[tile];
+  int size = state.tileSize[tile];
+  int firstExperiment = block * BLOCK_EXPERIMENTS;
+  int lastExperiment = min(firstExperiment + BLOCK_EXPERIMENTS, state.experimentLimit);
+  int count = state.schedulers;
+  double *cell = (state.shared != NULL) ? &state.shared->seekTime[(size_t)tile * count]
+					 : &state.blockSeekTime[(size_t)tile * count];
+  runningStat *stat = (state.shared != NULL) ? &state.shared->stat[(size_t)tile * count]
+					     : &state.blockStat[(size_t)tile * count];
+  const uint8_t *active = (state.active != NULL) ? &state.active[(size_t)(size - state.opts->firstSize) * count] : NULL;
+  int width = state.opts->interleave; // experiments run side by side
+  requestQueue *arrival[MAX_INTERLEAVE], *sorted[MAX_INTERLEAVE]; // queues of each lane
+  pathScratch *path[MAX_INTERLEAVE]; // scheduler scratch of each lane
+  schedulerLane lane[MAX_INTERLEAVE];
+  double average[MAX_INTERLEAVE]; // average seek time of each lane
+  rngStream rng;
+
+  arrival[0] = &arena.arrival;
+  sorted[0] = &arena.sorted;
+  path[0] = &arena.path;
+  for (int w = 1; w < width; w++)
+    {
+      arrival[w] = &arena.lanes[w - 1].arrival;
+      sorted[w] = &arena.lanes[w - 1].sorted;
+      path[w] = &arena.lanes[w - 1].path;
+    }
+
+  for (int alg = 0; alg < count; alg++)
+    {
+      clearHistogram(histogram[alg]);
+    }
+  if (state.raw != NULL)
+    raw.assign((size_t)(lastExperiment - firstExperiment) * (2 + count), NAN);
+
+  for (int group = firstExperiment; group < lastExperiment; group += width)
+    {
+      int lanes = min(width, lastExperiment - group); // experiments of this group
+
+      for (int w = 0; w < lanes; w++)
+	{
+	  int experiment = group + w;
+
+	  if (state.raw != NULL)
+	    {
+	      raw[(size_t)(experiment - firstExperiment) * (2 + count)] = experiment;
+	      raw[(size_t)(experiment - firstExperiment) * (2 + count) + 1] = size;
+	    }
+	  {
+	    scopedTimer timer(profile, PHASE_GENERATE, size);
+	    seedStream(rng, state.opts->seed, experiment, size);
+	    state.opts->generator(request, size, rng, arena);
+	  }
+	  {
+	    // call to function to get sorted request, as it is needed for every scheduler but fifo and nstep
+	    scopedTimer timer(profile, PHASE_SORT, size);
+	    state.opts->sorter(request, size, order, arena);
+	  }
+	  {
+	    scopedTimer timer(profile, PHASE_LOAD, 2 * size);
+	    loadQueue(*arrival[w], request, size);
+	    loadSortedQueue(*sorted[w], request, order, size);
+	  }
+	}
+
+      for (int alg = 0; alg < count; alg++)
+	{
+	  const schedulerInfo *scheduler = state.opts->schedulers[alg];
+	  latencyHistogram *recorded = state.opts->percentiles ? &histogram[alg] : NULL;
+
+	  if (active != NULL && !active[alg])
+	    continue;
+
+	  {
+	    scopedTimer timer(profile, PHASE_SCHEDULER + alg, (long)size * lanes);
+
+	    if (lanes > 1 && scheduler->lane != NULL)
+	      {
+		for (int w = 0; w < lanes; w++)
+		  {
+		    startLane(lane[w], scheduler->sorted ? *sorted[w] : *arrival[w], recorded, *path[w]);
+		  }
+		interleaveLanes(scheduler->lane, lane, lanes);
+		for (int w = 0; w < lanes; w++)
+		  {
+		    average[w] = lane[w].average;
+		  }
+	      }
+	    else
+	      {
+		for (int w = 0; w < lanes; w++)
+		  {
+		    const requestQueue &queue = scheduler->sorted ? *sorted[w] : *arrival[w];
+
+		    average[w] = scheduler->run(queue, state.opts->nstep, recorded, *path[w]);
+		  }
+	      }
+	  }
+	  for (int w = 0; w < lanes; w++)
+	    {
+	      cell[alg] += average[w];
+	      addSample(stat[alg], average[w]);
+	      if (state.raw != NULL)
+		raw[(size_t)(group + w - firstExperiment) * (2 + count) + 2 + alg] = average[w];
+	    }
+	}
+    }
+
+  if (state.raw != NULL)
+    sinkRows(*state.raw, raw.data(), lastExperiment - firstExperiment);
+
+  if (state.shared != NULL)
+    {
+      state.shared->tile[tile].phase.store(TILE_MERGING);
+      for (int alg = 0; alg < count && state.opts->percentiles; alg++)
+	{
+	  mergeShared(state.shared->histogram[(size_t)(size - state.opts->firstSize) * count + alg], histogram[alg]);
+	}
+      return;
+    }
+
+  if (!state.opts->percentiles)
+    return;
+  lock_guard<mutex> lock(state.histogramLock[size % HISTOGRAM_LOCKS]);
+  for (int alg = 0; alg < count; alg++)
+    {
+      mergeHistogram(state.sizeHistogram[(size_t)(size - state.opts->firstSize) * count + alg], histogram[alg]);
+    }
+}
+
+/***************************************************************************
+ * void sweepWorker(sweepState &)
+ * Date: 17 October 2026
+ * Description: body of a worker thread. Keeps taking tiles until none are
+ *left, and reports progress whenever it finishes the last tile of a block.
+ *When the sweep is profiled the worker opens its own hardware counters
+ *(they only count the thread that opened them).
+ *
+ * Parameters:
+ * state I/O sweepState&  shared sweep state
+ **************************************************************************/
+void sweepWorker(sweepState &state)
+{
+  // each worker has its own scratch buffers, sized for the largest request once
+  workerArena arena;
+  unique_ptr<latencyHistogram[]> histogram(new latencyHistogram[state.schedulers]);
+  phaseProfile profile;
+  vector<double> raw; // rows of the tile for state.raw
+  int tile;
+
+  reserveArena(arena, state.opts->lastSize);
+  if (state.opts->interleave > 1)
+    reserveLanes(arena, state.opts->interleave, state.opts->lastSize);
+  if (state.profile != NULL)
+    {
+      clearProfile(profile, state.opts->schedulers);
+      if (state.opts->perf)
+	openPerfCounters(profile.perf);
+    }
+
+  while ((tile = (state.shared != NULL) ? claimTile(*state.shared) : state.nextTile.fetch_add(1)) < state.tiles)
+    {
+      runTile(state, tile, arena, histogram.get(), state.profile != NULL ? &profile : NULL, raw);
+      if (state.shared != NULL)
+	finishTile(*state.shared, tile);
+
+      int block = state.tileBlock[tile];
+      atomic<int> *remaining = (state.shared != NULL) ? state.shared->blockRemaining : state.blockRemaining.get();
+      if (remaining != NULL && remaining[block].fetch_sub(1) == 1 && !state.opts->quiet) // last tile of the block
+	{
+	  int first = block * BLOCK_EXPERIMENTS + 1;
+	  int last = min(first + BLOCK_EXPERIMENTS - 1, state.opts->experiments);
+
+	  lock_guard<mutex> lock(state.outputLock);
+	  cout << "Experiments " << first << "-" << last << " complete.\n";
+	}
+    }
+
+  if (state.profile != NULL)
+    {
+      closePerfCounters(profile.perf);
+      lock_guard<mutex> lock(state.outputLock);
+      mergeProfile(*state.profile, profile);
+    }
+}
+
+/***************************************************************************
+ * string checkpointKey(const simulationOptions &)
+ * Date: 17 October 2026
+ * Description: describes every option the results of a sweep depend on, so
+ *a checkpoint is only resumed by the same sweep. Threads are left out, as
+ *the results do not depend on them.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  options of the sweep
+ * checkpointKey O/P string  the description
+ **************************************************************************/
+string checkpointKey(const simulationOptions &opts)
+{
+  string key = "seed " + to_string(opts.seed) + " experiments " + to_string(opts.experiments) + " sizes " +
+	       to_string(opts.firstSize) + "-" + to_string(opts.lastSize) + " nstep " + to_string(opts.nstep) +
+	       " generator " + generatorName(opts) + " disk " +
+	       (opts.disk != NULL ? opts.disk : "classic") + " schedulers";
+
+  for (const schedulerInfo *scheduler : opts.schedulers)
+    {
+      key += " ";
+      key += scheduler->name;
+    }
+  if (!opts.percentiles)
+    key += " no percentiles"; // the histograms are empty
+  return key;
+}
+
+/***************************************************************************
+ * bool writeCheckpoint(const simulationOptions &, int, const vector<double> &, const vector<latencyHistogram> &, const vector<runningStat> &)
+ * Date: 17 October 2026
+ * Description: saves the accumulators of a fixed sweep after its first
+ *blocksDone experiment blocks to opts.checkpoint. The file starts with
+ *CHECKPOINT_MAGIC and checkpointKey, then the block count, the summed seek
+ *times and running statistics of every cell, and every histogram with only
+ *its range of non-empty buckets. Nothing else needs saving: every
+ *experiment's random stream is seeded by its index, so the rest of the
+ *sweep picks up where it left off. The file is written next to the old one
+ *and renamed over it once it is on disk, so a kill at any moment leaves
+ *either the old checkpoint or the new one.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  sweep being saved, and the file it goes to
+ * blocksDone I/P int  experiment blocks included in the accumulators
+ * seekTime I/P const vector<double>&  summed average seek times [size - opts.firstSize][scheduler]
+ * histogram I/P const vector<latencyHistogram>&  service times [size - opts.firstSize][scheduler]
+ * stats I/P const vector<runningStat>&  running statistics [size - opts.firstSize][scheduler]
+ * writeCheckpoint O/P bool  false if the checkpoint could not be written
+ **************************************************************************/
+bool writeCheckpoint(const simulationOptions &opts, int blocksDone, const vector<double> &seekTime,
+		     const vector<latencyHistogram> &histogram, const vector<runningStat> &stats)
+{
+  string temporary = string(opts.checkpoint) + ".tmp";
+  string key = checkpointKey(opts);
+  uint32_t keyLength = key.size(), cells = seekTime.size();
+  FILE *file = fopen(temporary.c_str(), "wb");
+  bool written = (file != NULL);
+
+  if (written)
+    {
+      written &= fwrite(CHECKPOINT_MAGIC, 1, sizeof(CHECKPOINT_MAGIC), file) == sizeof(CHECKPOINT_MAGIC);
+      written &= fwrite(&keyLength, 4, 1, file) == 1;
+      written &= fwrite(key.data(), 1, keyLength, file) == keyLength;
+      written &= fwrite(&blocksDone, 4, 1, file) == 1;
+      written &= fwrite(&cells, 4, 1, file) == 1;
+      written &= fwrite(seekTime.data(), sizeof(double), cells, file) == cells;
+      for (uint32_t i = 0; i < cells; i++)
+	{
+	  const latencyHistogram &h = histogram[i];
+	  int64_t count = stats[i].count;
+	  uint32_t first = 0, end = HISTOGRAM_BUCKETS;
+
+	  while (first < end && h.counts[first] == 0)
+	    first++;
+	  while (end > first && h.counts[end - 1] == 0)
+	    end--;
+	  written &= fwrite(&count, 8, 1, file) == 1;
+	  written &= fwrite(&stats[i].mean, sizeof(double), 1, file) == 1;
+	  written &= fwrite(&stats[i].m2, sizeof(double), 1, file) == 1;
+	  written &= fwrite(&h.total, 8, 1, file) == 1;
+	  written &= fwrite(&h.sum, sizeof(double), 1, file) == 1;
+	  written &= fwrite(&h.max, sizeof(double), 1, file) == 1;
+	  written &= fwrite(&first, 4, 1, file) == 1;
+	  written &= fwrite(&end, 4, 1, file) == 1;
+	  written &= fwrite(h.counts + first, 8, end - first, file) == end - first;
+	}
+      written &= (fflush(file) == 0);
+#ifdef __linux__
+      written &= (fsync(fileno(file)) == 0);
+#endif
+      written &= (fclose(file) == 0);
+    }
+  if (written && rename(temporary.c_str(), opts.checkpoint) == 0)
+    return true;
+
+  cerr << "could not write checkpoint " << opts.checkpoint << " (" << strerror(errno) << ")\n";
+  remove(temporary.c_str());
+  return false;
+}
+
+/***************************************************************************
+ * bool readCheckpoint(const simulationOptions &, int &, vector<double> &, vector<latencyHistogram> &, vector<runningStat> &)
+ * Date: 17 October 2026
+ * Description: loads the accumulators saved by writeCheckpoint (--resume).
+ *A checkpoint left by a sweep with different options is refused rather
+ *than mixed into this one.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  sweep being resumed, and the file it was saved to
+ * blocksDone O/P int  experiment blocks already in the accumulators
+ * seekTime O/P vector<double>&  summed average seek times [size - opts.firstSize][scheduler]
+ * histogram O/P vector<latencyHistogram>&  service times [size - opts.firstSize][scheduler]
+ * stats O/P vector<runningStat>&  running statistics [size - opts.firstSize][scheduler]
+ * readCheckpoint O/P bool  false if the checkpoint could not be read or is of another sweep
+ **************************************************************************/
+bool readCheckpoint(const simulationOptions &opts, int &blocksDone, vector<double> &seekTime,
+		    vector<latencyHistogram> &histogram, vector<runningStat> &stats)
+{
+  string key = checkpointKey(opts);
+  size_t expected = (size_t)(opts.lastSize - opts.firstSize + 1) * opts.schedulers.size();
+  FILE *file = fopen(opts.checkpoint, "rb");
+  char magic[sizeof(CHECKPOINT_MAGIC)];
+  uint32_t keyLength = 0, cells = 0;
+  string saved;
+  bool read;
+
+  if (file == NULL)
+    {
+      cerr << "could not open checkpoint " << opts.checkpoint << " (" << strerror(errno) << ")\n";
+      return false;
+    }
+  read = fread(magic, 1, sizeof(magic), file) == sizeof(magic) && memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) == 0 &&
+	 fread(&keyLength, 4, 1, file) == 1 && keyLength < (1u << 20);
+  if (read)
+    {
+      saved.resize(keyLength);
+      read = fread(&saved[0], 1, keyLength, file) == keyLength && fread(&blocksDone, 4, 1, file) == 1 &&
+	     fread(&cells, 4, 1, file) == 1;
+    }
+  if (read && (saved != key || cells != expected))
+    {
+      cerr << "checkpoint " << opts.checkpoint << " is of another sweep (" << saved << ")\n";
+      fclose(file);
+      return false;
+    }
+
+  seekTime.assign(expected, 0);
+  stats.assign(expected, runningStat());
+  histogram.resize(expected);
+  read = read && fread(seekTime.data(), sizeof(double), cells, file) == cells;
+  for (uint32_t i = 0; read && i < cells; i++)
+    {
+      latencyHistogram &h = histogram[i];
+      int64_t count;
+      uint32_t first, end;
+
+      clearHistogram(h);
+      read = fread(&count, 8, 1, file) == 1 && fread(&stats[i].mean, sizeof(double), 1, file) == 1 &&
+	     fread(&stats[i].m2, sizeof(double), 1, file) == 1 && fread(&h.total, 8, 1, file) == 1 &&
+	     fread(&h.sum, sizeof(double), 1, file) == 1 && fread(&h.max, sizeof(double), 1, file) == 1 &&
+	     fread(&first, 4, 1, file) == 1 && fread(&end, 4, 1, file) == 1 && first <= end &&
+	     end <= (uint32_t)HISTOGRAM_BUCKETS && fread(h.counts + first, 8, end - first, file) == end - first;
+      stats[i].count = count;
+    }
+  fclose(file);
+
+  if (!read || blocksDone < 0)
+    {
+      cerr << "checkpoint " << opts.checkpoint << " is damaged\n";
+      return false;
+    }
+  return true;
+}
+
+/***************************************************************************
+ * double runSweep(const simulationOptions &, vector<double> &, vector<latencyHistogram> &, vector<runningStat> &, phaseProfile *, resultsSink *, int)
+ * Date: 17 October 2026
+ * Description: runs opts.experiments experiments for every request size
+ *from opts.firstSize to opts.lastSize on opts.threads worker threads and stores the summed average
+ *seek times of every selected scheduler in seekTime, their running
+ *statistics in stats and the service time of every request in histogram.
+ *With opts.checkpoint the blocks are run in epochs of a few blocks, and
+ *after an epoch the accumulators are saved (writeCheckpoint) if
+ *opts.checkpointSeconds have passed since the last save, and always after
+ *the last one. A resumed sweep starts at firstBlock with the accumulators
+ *read back by readCheckpoint; blocks are still merged one at a time in
+ *order, so it ends with the same results as a sweep that was never stopped.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  number of experiments, threads, seed and schedulers
+ * seekTime I/O vector<double>&  summed average seek times [size - opts.firstSize][scheduler]
+ * histogram I/O vector<latencyHistogram>&  service times [size - opts.firstSize][scheduler]
+ * stats I/O vector<runningStat>&  mean and variance of the average seek times [size - opts.firstSize][scheduler]
+ * profile O/P phaseProfile*  time of every phase of the sweep, or NULL to not profile it
+ * raw I/O resultsSink*  sink every experiment's results are written to, or NULL
+ * firstBlock I/P int  experiment blocks already in the accumulators, 0 to start from nothing
+ * runSweep O/P double  wall clock time of the sweep in seconds
+ **************************************************************************/
+double runSweep(const simulationOptions &opts, vector<double> &seekTime, vector<latencyHistogram> &histogram,
+		vector<runningStat> &stats, phaseProfile *profile, resultsSink *raw, int firstBlock)
+{
+  int count = opts.schedulers.size();
+  int numSizes = opts.lastSize - opts.firstSize + 1;
+  int blocks = (opts.experiments + BLOCK_EXPERIMENTS - 1) / BLOCK_EXPERIMENTS;
+  int epochBlocks = blocks; // without checkpoints the whole sweep is one epoch
+
+  auto start = chrono::steady_clock::now();
+  auto saved = start; // time of the last checkpoint
+
+  if (opts.checkpoint != NULL)
+    epochBlocks = max(1, (opts.threads * EPOCH_TILES_PER_THREAD + numSizes - 1) / numSizes);
+  if (firstBlock == 0)
+    {
+      seekTime.assign((size_t)numSizes * count, 0);
+      stats.assign((size_t)numSizes * count, runningStat());
+      histogram.resize((size_t)numSizes * count);
+      for (size_t i = 0; i < histogram.size(); i++)
+	{
+	  clearHistogram(histogram[i]);
+	}
+    }
+  if (profile != NULL)
+    clearProfile(*profile, opts.schedulers);
+
+  for (int epoch = firstBlock; epoch < blocks; epoch += epochBlocks)
+    {
+      int epochEnd = min(epoch + epochBlocks, blocks);
+      sweepState state;
+      vector<thread> workers;
+
+      state.opts = &opts;
+      state.blocks = blocks;
+      state.tiles = (epochEnd - epoch) * numSizes;
+      state.tileBlock.resize(state.tiles);
+      state.tileSize.resize(state.tiles);
+      for (int tile = 0; tile < state.tiles; tile++)
+	{
+	  state.tileBlock[tile] = epoch + tile / numSizes;
+	  state.tileSize[tile] = opts.firstSize + (tile % numSizes);
+	}
+      state.experimentLimit = opts.experiments;
+      state.active = NULL;
+      state.nextTile = 0;
+      state.schedulers = count;
+      state.blockSeekTime.assign((size_t)state.tiles * count, 0);
+      state.blockStat.assign((size_t)state.tiles * count, runningStat());
+      state.blockRemaining.reset(new atomic<int>[blocks]);
+      for (int block = epoch; block < epochEnd; block++)
+	{
+	  state.blockRemaining[block] = numSizes;
+	}
+      state.sizeHistogram = histogram.data();
+      state.profile = profile;
+      state.raw = raw;
+      state.shared = NULL;
+
+      for (int i = 0; i < opts.threads; i++)
+	{
+	  workers.push_back(thread(sweepWorker, ref(state)));
+	}
+      for (size_t i = 0; i < workers.size(); i++)
+	{
+	  workers[i].join();
+	}
+
+      // merge the tile accumulators in block order so the sums do not depend on scheduling
+      for (int block = 0; block < epochEnd - epoch; block++)
+	{
+	  for (int i = 0; i < numSizes * count; i++)
+	    {
+	      seekTime[i] += state.blockSeekTime[(size_t)block * numSizes * count + i];
+	      mergeStat(stats[i], state.blockStat[(size_t)block * numSizes * count + i]);
+	    }
+	}
+
+      chrono::duration<double> sinceSaved = chrono::steady_clock::now() - saved;
+      if (opts.checkpoint != NULL && (epochEnd == blocks || sinceSaved.count() >= opts.checkpointSeconds))
+	{
+	  writeCheckpoint(opts, epochEnd, seekTime, histogram, stats);
+	  saved = chrono::steady_clock::now();
+	}
+    }
+
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+/***************************************************************************
+ * bool mapShared(const char *, bool, sharedSweep &)
+ * Date: 17 October 2026
+ * Description: maps the region of a shared sweep another process created.
+ *Waits up to SHARED_WAIT_MS for the creator to size and fill it in, then
+ *checks it is a shared sweep region of the size its header says.
+ *
+ * Parameters:
+ * path I/P const char*  region file
+ * writable I/P bool  map it to join the sweep rather than only read it
+ * shared O/P sharedSweep&  view of the region
+ * mapShared O/P bool  false if the file could not be mapped or is not a shared sweep region
+ **************************************************************************/
+bool mapShared(const char *path, bool writable, sharedSweep &shared)
+{
+#ifdef __linux__
+  int fd = open(path, writable ? O_RDWR : O_RDONLY);
+  struct stat info;
+  int waited = 0;
+
+  if (fd < 0)
+    {
+      cerr << "could not open shared sweep " << path << " (" << strerror(errno) << ")\n";
+      return false;
+    }
+  while (fstat(fd, &info) == 0 && (size_t)info.st_size < sizeof(sharedHeader) && waited < SHARED_WAIT_MS)
+    {
+      usleep(10000);
+      waited += 10;
+    }
+  if ((size_t)info.st_size < sizeof(sharedHeader))
+    {
+      cerr << path << " is not a shared sweep\n";
+      close(fd);
+      return false;
+    }
+
+  void *base = mmap(NULL, info.st_size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED)
+    {
+      cerr << "could not map shared sweep " << path << " (" << strerror(errno) << ")\n";
+      return false;
+    }
+
+  sharedHeader &header = *(sharedHeader *)base;
+  while (!header.ready.load() && waited < SHARED_WAIT_MS)
+    {
+      usleep(10000);
+      waited += 10;
+    }
+  if (memcmp(header.magic, SHARED_MAGIC, sizeof(SHARED_MAGIC)) != 0 || !header.ready.load() ||
+      layoutShared(header, &shared) != (size_t)info.st_size)
+    {
+      cerr << path << " is not a shared sweep\n";
+      munmap(base, info.st_size);
+      return false;
+    }
+  shared.finisher = false;
+  return true;
+#else
+  cerr << "shared sweeps need Linux\n";
+  return false;
+#endif
+}
+
+/***************************************************************************
+ * void closeShared(sharedSweep &)
+ * Date: 17 October 2026
+ * Description: unmaps the region of a shared sweep. The file is left for
+ *--status and for processes that still have it mapped.
+ *
+ * Parameters:
+ * shared I/O sharedSweep&  view to be unmapped
+ **************************************************************************/
+void closeShared(sharedSweep &shared)
+{
+#ifdef __linux__
+  munmap(shared.header, shared.bytes);
+#endif
+  shared.header = NULL;
+}
+
+/***************************************************************************
+ * bool openShared(const simulationOptions &, sharedSweep &)
+ * Date: 17 October 2026
+ * Description: creates the region of the shared sweep opts.shared, or
+ *joins it if another process already has. Exactly one process creates the
+ *file (O_EXCL); it sizes it, fills in the header and block counters and
+ *sets ready last. A process joining a region of another sweep, or of one
+ *that is already finished, is refused.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  options of the sweep, and the region file
+ * shared O/P sharedSweep&  view of the region
+ * openShared O/P bool  false if the region could not be created or joined
+ **************************************************************************/
+bool openShared(const simulationOptions &opts, sharedSweep &shared)
+{
+#ifdef __linux__
+  string key = checkpointKey(opts);
+  int numSizes = opts.lastSize - opts.firstSize + 1;
+  sharedHeader counts; // only the counts, to size the region
+
+  if (key.size() >= (size_t)SHARED_KEY_BYTES)
+    {
+      cerr << "too many options to share the sweep\n";
+      return false;
+    }
+  counts.blocks = (opts.experiments + BLOCK_EXPERIMENTS - 1) / BLOCK_EXPERIMENTS;
+  counts.tiles = counts.blocks * numSizes;
+  counts.sizes = numSizes;
+  counts.schedulers = opts.schedulers.size();
+  size_t bytes = layoutShared(counts, NULL);
+
+  int fd = open(opts.shared, O_RDWR | O_CREAT | O_EXCL, 0644);
+  if (fd < 0 && errno == EEXIST)
+    {
+      if (!mapShared(opts.shared, true, shared))
+	return false;
+      if (strcmp(shared.header->key, key.c_str()) != 0)
+	cerr << "shared sweep " << opts.shared << " is of another sweep (" << shared.header->key << ")\n";
+      else if (shared.header->finished.load())
+	cerr << "shared sweep " << opts.shared << " is already finished, remove it to run the sweep again\n";
+      else
+	return true;
+      closeShared(shared);
+      return false;
+    }
+
+  void *base = MAP_FAILED;
+  if (fd >= 0 && ftruncate(fd, bytes) == 0)
+    base = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED)
+    {
+      cerr << "could not create shared sweep " << opts.shared << " (" << strerror(errno) << ")\n";
+      if (fd >= 0)
+	{
+	  close(fd);
+	  remove(opts.shared);
+	}
+      return false;
+    }
+  close(fd);
+
+  // the file starts out zero, which is every counter's starting value
+  sharedHeader &header = *(sharedHeader *)base;
+  memcpy(header.magic, SHARED_MAGIC, sizeof(SHARED_MAGIC));
+  strcpy(header.key, key.c_str());
+  header.blocks = counts.blocks;
+  header.tiles = counts.tiles;
+  header.sizes = counts.sizes;
+  header.schedulers = counts.schedulers;
+  header.firstSize = opts.firstSize;
+  header.experiments = opts.experiments;
+  for (int alg = 0; alg < header.schedulers; alg++)
+    {
+      header.scheduler[alg] = opts.schedulers[alg] - SCHEDULERS;
+    }
+  header.startNs = chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch()).count();
+  layoutShared(header, &shared);
+  for (int block = 0; block < header.blocks; block++)
+    {
+      shared.blockRemaining[block] = numSizes;
+    }
+  shared.finisher = false;
+  header.ready.store(1);
+  return true;
+#else
+  cerr << "shared sweeps need Linux\n";
+  return false;
+#endif
+}
+
+/***************************************************************************
+ * bool runShared(const simulationOptions &, vector<double> &, vector<latencyHistogram> &, vector<runningStat> &, phaseProfile *, resultsSink *, double &, bool &)
+ * Date: 17 October 2026
+ * Description: runs this process's part of a fixed sweep shared by
+ *several processes through the memory mapped region opts.shared (--shared).
+ *Each process started with the same options takes tiles from the region on
+ *its own opts.threads workers, so the sweep can be spread over processes
+ *pinned to different NUMA nodes, and a process that dies only loses the
+ *tiles it was running (the others take them over). The process that
+ *completes the last tile merges the tiles' seek times and statistics in
+ *block order, as runSweep does, and reads the histograms out of the
+ *region; the others stop once no tiles are left for them.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  options of the sweep and the region file
+ * seekTime O/P vector<double>&  summed average seek times [size - opts.firstSize][scheduler], if finished
+ * histogram O/P vector<latencyHistogram>&  service times [size - opts.firstSize][scheduler], if finished
+ * stats O/P vector<runningStat>&  running statistics [size - opts.firstSize][scheduler], if finished
+ * profile O/P phaseProfile*  time of every phase of this process's tiles, or NULL to not profile them
+ * raw I/O resultsSink*  sink the experiments of this process's tiles are written to, or NULL
+ * seconds O/P double&  wall clock time this process ran for
+ * finished O/P bool&  true if this process completed the sweep and has its results
+ * runShared O/P bool  false if the region could not be created or joined
+ **************************************************************************/
+bool runShared(const simulationOptions &opts, vector<double> &seekTime, vector<latencyHistogram> &histogram,
+	       vector<runningStat> &stats, phaseProfile *profile, resultsSink *raw, double &seconds, bool &finished)
+{
+  int count = opts.schedulers.size();
+  int numSizes = opts.lastSize - opts.firstSize + 1;
+  sharedSweep shared;
+  sweepState state;
+  vector<thread> workers;
+
+  auto start = chrono::steady_clock::now();
+
+  if (!openShared(opts, shared))
+    return false;
+  if (profile != NULL)
+    clearProfile(*profile, opts.schedulers);
+
+  state.opts = &opts;
+  state.blocks = shared.header->blocks;
+  state.tiles = shared.header->tiles;
+  state.tileBlock.resize(state.tiles);
+  state.tileSize.resize(state.tiles);
+  for (int tile = 0; tile < state.tiles; tile++)
+    {
+      state.tileBlock[tile] = tile / numSizes;
+      state.tileSize[tile] = opts.firstSize + (tile % numSizes);
+    }
+  state.experimentLimit = opts.experiments;
+  state.active = NULL;
+  state.nextTile = 0;
+  state.schedulers = count;
+  state.sizeHistogram = NULL;
+  state.profile = profile;
+  state.raw = raw;
+  state.shared = &shared;
+
+  for (int i = 0; i < opts.threads; i++)
+    {
+      workers.push_back(thread(sweepWorker, ref(state)));
+    }
+  for (size_t i = 0; i < workers.size(); i++)
+    {
+      workers[i].join();
+    }
+
+  finished = shared.finisher;
+  if (finished)
+    {
+      seekTime.assign((size_t)numSizes * count, 0);
+      stats.assign((size_t)numSizes * count, runningStat());
+      histogram.resize((size_t)numSizes * count);
+      for (int block = 0; block < state.blocks; block++)
+	{
+	  for (int i = 0; i < numSizes * count; i++)
+	    {
+	      seekTime[i] += shared.seekTime[(size_t)block * numSizes * count + i];
+	      mergeStat(stats[i], shared.stat[(size_t)block * numSizes * count + i]);
+	    }
+	}
+      for (int i = 0; i < numSizes * count; i++)
+	{
+	  loadShared(histogram[i], shared.histogram[i]);
+	}
+      if (shared.header->damaged.load() > 0)
+	cerr << "service times of " << shared.header->damaged.load()
+	     << " tiles are incomplete, a process died while adding them in\n";
+    }
+  closeShared(shared);
+
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  seconds = elapsed.count();
+  return true;
+}
+
+/***************************************************************************
+ * int sharedStatus(const char *)
+ * Date: 17 October 2026
+ * Description: reports on a shared sweep while it runs (--status): how many
+ *tiles are done, running and waiting, the processes running them (and
+ *tiles left by processes that died), the throughput in experiments per
+ *second since the sweep started, the time left at that rate, and the
+ *average seek times of the tiles done so far as comma separated text. The
+ *region is only mapped for reading and nothing is locked, so the workers
+ *are not disturbed; a tile's results are only read once it is done.
+ *
+ * Parameters:
+ * path I/P const char*  region file of the sweep
+ * sharedStatus O/P int  exit status, 1 if the region could not be read
+ **************************************************************************/
+int sharedStatus(const char *path)
+{
+  sharedSweep shared;
+
+  if (!mapShared(path, false, shared))
+    return 1;
+
+  const sharedHeader &header = *shared.header;
+  int count = header.schedulers;
+  int phases[4] = { 0 }; // tiles in each tilePhase
+  int orphaned = 0; // tiles handed to processes that no longer exist
+  long experimentsDone = 0;
+  vector<int32_t> processes; // processes running tiles
+  vector<uint8_t> done(header.tiles);
+
+  for (int tile = 0; tile < header.tiles; tile++)
+    {
+      int phase = shared.tile[tile].phase.load();
+      int32_t owner = shared.tile[tile].owner.load();
+
+      phases[phase]++;
+      done[tile] = (phase == TILE_DONE);
+      if (done[tile])
+	experimentsDone += min(BLOCK_EXPERIMENTS, header.experiments - tile / header.sizes * BLOCK_EXPERIMENTS);
+      else if (owner == 0 ? tile < header.nextTile.load() : !processAlive(owner))
+	orphaned++; // handed out with no owner (or one being set), or its owner died
+      else if (owner != 0 && find(processes.begin(), processes.end(), owner) == processes.end())
+	processes.push_back(owner);
+    }
+
+  long experiments = (long)header.experiments * header.sizes;
+  double now = header.finished.load() ? header.endNs.load()
+				      : chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch()).count();
+  double elapsed = max(1e-9, (now - header.startNs) / 1e9);
+  double rate = experimentsDone / elapsed;
+
+  cout << "Sweep:\t\t" << header.key << "\n"
+       << "Tiles:\t\t" << phases[TILE_DONE] << " done, " << phases[TILE_RUNNING] + phases[TILE_MERGING] << " running, "
+       << phases[TILE_WAITING] << " waiting, of " << header.tiles << "\n"
+       << "Processes:\t";
+  for (int32_t pid : processes)
+    {
+      cout << pid << " ";
+    }
+  cout << "(" << processes.size() << ")\n";
+  if (orphaned > 0)
+    cout << "Orphaned:\t" << orphaned << " tiles of processes that died, start another process to run them\n";
+  if (header.damaged.load() > 0)
+    cout << "Damaged:\t" << header.damaged.load() << " tiles with incomplete service times\n";
+  cout << "Experiments:\t" << experimentsDone << " of " << experiments << " (" << (100.0 * experimentsDone / experiments)
+       << "%)\n"
+       << "Throughput:\t" << rate << " experiments/s over " << elapsed << " s\n"
+       << "ETA:\t\t";
+  if (header.finished.load())
+    cout << "finished\n";
+  else if (rate > 0)
+    cout << (experiments - experimentsDone) / rate << " s\n";
+  else
+    cout << "unknown\n";
+
+  // partial results, from the tiles done so far, merged in block order
+  cout << "Size";
+  for (int alg = 0; alg < count; alg++)
+    {
+      cout << ", " << SCHEDULERS[header.scheduler[alg]].label;
+    }
+  cout << ", Experiments\n";
+  for (int size = 0; size < header.sizes; size++)
+    {
+      vector<double> sum(count, 0);
+      long n = 0;
+
+      for (int block = 0; block < header.blocks; block++)
+	{
+	  int tile = block * header.sizes + size;
+
+	  if (!done[tile])
+	    continue;
+	  for (int alg = 0; alg < count; alg++)
+	    {
+	      sum[alg] += shared.seekTime[(size_t)tile * count + alg];
+	    }
+	  n += shared.stat[(size_t)tile * count].count;
+	}
+      if (n == 0)
+	continue;
+      cout << header.firstSize + size;
+      for (int alg = 0; alg < count; alg++)
+	{
+	  cout << ", " << sum[alg] / n;
+	}
+      cout << ", " << n << "\n";
+    }
+
+  closeShared(shared);
+  return 0;
+}
+
+/***************************************************************************
+ * double runAdaptive(const simulationOptions &, vector<double> &, vector<latencyHistogram> &, vector<runningStat> &, phaseProfile *, resultsSink *)
+ * Date: 17 October 2026
+ * Description: adaptive sweep (--ci-target). Runs the experiments in rounds
+ *of one block per request size and keeps a running mean and variance of
+ *every (size, scheduler) cell. A cell stops being sampled once it has had
+ *opts.minExperiments experiments and the half width of its 95% confidence
+ *interval is at most opts.ciTarget. The budget is the scheduler runs of the
+ *fixed sweep (opts.experiments per cell); what converged cells save goes to
+ *the cells that are still noisy, the noisiest first once a whole round no
+ *longer fits. Every size's experiments are numbered in order as in the
+ *fixed sweep and rounds are merged in size order, so results are still the
+ *same for any number of threads.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  target, budget, threads, seed and schedulers
+ * seekTime O/P vector<double>&  summed average seek times [size - opts.firstSize][scheduler]
+ * histogram O/P vector<latencyHistogram>&  service times [size - opts.firstSize][scheduler]
+ * stats O/P vector<runningStat>&  mean and variance of the average seek times [size - opts.firstSize][scheduler]
+ * profile O/P phaseProfile*  time of every phase over all rounds, or NULL to not profile them
+ * raw I/O resultsSink*  sink every experiment's results are written to, or NULL
+ * runAdaptive O/P double  wall clock time of the sweep in seconds
+ **************************************************************************/
+double runAdaptive(const simulationOptions &opts, vector<double> &seekTime, vector<latencyHistogram> &histogram,
+		   vector<runningStat> &stats, phaseProfile *profile, resultsSink *raw)
+{
+  int count = opts.schedulers.size();
+  int numSizes = opts.lastSize - opts.firstSize + 1;
+  long budget = (long)opts.experiments * numSizes * count; // scheduler runs of the fixed sweep
+  long used = 0;
+  vector<uint8_t> active((size_t)numSizes * count, 1); // cells still being sampled
+  vector<int> nextBlock(numSizes, 0); // next experiment block of each size
+  vector<double> noise(numSizes); // widest interval of each size over the target
+
+  auto start = chrono::steady_clock::now();
+
+  seekTime.assign((size_t)numSizes * count, 0);
+  stats.assign((size_t)numSizes * count, runningStat());
+  histogram.resize((size_t)numSizes * count);
+  for (size_t i = 0; i < histogram.size(); i++)
+    {
+      clearHistogram(histogram[i]);
+    }
+  if (profile != NULL)
+    clearProfile(*profile, opts.schedulers);
+
+  for (int round = 1; ; round++)
+    {
+      vector<int> waiting, sizes; // sizes with active cells, and those run this round
+      long cost = 0;
+
+      for (int i = 0; i < numSizes; i++)
+	{
+	  noise[i] = 0;
+	  for (int alg = 0; alg < count; alg++)
+	    {
+	      if (active[i * count + alg])
+		noise[i] = max(noise[i], statHalfWidth(stats[i * count + alg]) / opts.ciTarget);
+	    }
+	  if (noise[i] > 0)
+	    waiting.push_back(i);
+	}
+      stable_sort(waiting.begin(), waiting.end(), [&noise](int a, int b) { return noise[a] > noise[b]; });
+      for (size_t w = 0; w < waiting.size(); w++)
+	{
+	  int i = waiting[w];
+	  long runs = 0;
+
+	  for (int alg = 0; alg < count; alg++)
+	    runs += active[i * count + alg] * BLOCK_EXPERIMENTS;
+	  if (used + cost + runs <= budget)
+	    {
+	      sizes.push_back(i);
+	      cost += runs;
+	    }
+	}
+      if (sizes.empty())
+	break;
+      sort(sizes.begin(), sizes.end());
+
+      sweepState state;
+      vector<thread> workers;
+
+      state.opts = &opts;
+      state.blocks = 0;
+      state.tiles = sizes.size();
+      state.tileBlock.resize(state.tiles);
+      state.tileSize.resize(state.tiles);
+      for (int tile = 0; tile < state.tiles; tile++)
+	{
+	  state.tileBlock[tile] = nextBlock[sizes[tile]]++;
+	  state.tileSize[tile] = opts.firstSize + sizes[tile];
+	}
+      state.experimentLimit = INT_MAX;
+      state.active = active.data();
+      state.nextTile = 0;
+      state.schedulers = count;
+      state.blockSeekTime.assign((size_t)state.tiles * count, 0);
+      state.blockStat.assign((size_t)state.tiles * count, runningStat());
+      state.sizeHistogram = histogram.data();
+      state.profile = profile;
+      state.raw = raw;
+      state.shared = NULL;
+
+      for (int i = 0; i < min(opts.threads, state.tiles); i++)
+	{
+	  workers.push_back(thread(sweepWorker, ref(state)));
+	}
+      for (size_t i = 0; i < workers.size(); i++)
+	{
+	  workers[i].join();
+	}
+
+      // merge in size order, then stop sampling the cells that are narrow enough
+      for (int tile = 0; tile < state.tiles; tile++)
+	{
+	  for (int alg = 0; alg < count; alg++)
+	    {
+	      size_t cell = (size_t)sizes[tile] * count + alg;
+
+	      seekTime[cell] += state.blockSeekTime[(size_t)tile * count + alg];
+	      mergeStat(stats[cell], state.blockStat[(size_t)tile * count + alg]);
+	      if (active[cell] && stats[cell].count >= opts.minExperiments && statHalfWidth(stats[cell]) <= opts.ciTarget)
+		active[cell] = 0;
+	    }
+	}
+      used += cost;
+
+      if (!opts.quiet)
+	{
+	  cout << "Round " << round << " complete, " << count_if(active.begin(), active.end(), [](uint8_t a) { return a != 0; })
+	       << " of " << active.size() << " cells still sampling.\n";
+	}
+    }
+
+  cout << "Adaptive sweep used " << used << " of " << budget << " scheduler runs ("
+       << (100.0 * used / budget) << "%).\n";
+
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+/***************************************************************************
+ * double scalingReport(const simulationOptions &, vector<double> &, vector<latencyHistogram> &, vector<runningStat> &, phaseProfile *, resultsSink *)
+ * Date: 17 October 2026
+ * Description: runs the same sweep with 1, 2, 4, ... up to opts.threads
+ *threads and prints wall time, speedup and parallel efficiency for each,
+ *along with whether the results matched the single threaded run bit for bit.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  sweep to be measured
+ * seekTime O/P vector<double>&  results of the last (widest) run
+ * histogram O/P vector<latencyHistogram>&  service times of the last (widest) run
+ * stats O/P vector<runningStat>&  running statistics of the last (widest) run
+ * profile O/P phaseProfile*  time of every phase of the last (widest) run, or NULL
+ * raw I/O resultsSink*  sink the experiments of the last (widest) run are written to, or NULL
+ * scalingReport O/P double  wall clock time of the last (widest) run in seconds
+ **************************************************************************/
+double scalingReport(const simulationOptions &opts, vector<double> &seekTime, vector<latencyHistogram> &histogram,
+		     vector<runningStat> &stats, phaseProfile *profile, resultsSink *raw)
+{
+  vector<double> baseline;
+  simulationOptions run = opts;
+  double baseSeconds = 0;
+
+  run.quiet = true;
+
+  cout << "Threads\tSeconds\t\tSpeedup\t\tEfficiency\tIdentical\n";
+  for (int threads = 1; ; threads = min(threads * 2, opts.threads))
+    {
+      run.threads = threads;
+      double seconds = runSweep(run, (threads == 1) ? baseline : seekTime, histogram, stats,
+				(threads == opts.threads) ? profile : NULL, (threads == opts.threads) ? raw : NULL, 0);
+      bool identical = true;
+
+      if (threads == 1)
+	{
+	  baseSeconds = seconds;
+	  seekTime = baseline;
+	}
+      else
+	{
+	  identical = (memcmp(seekTime.data(), baseline.data(), baseline.size() * sizeof(double)) == 0);
+	}
+
+      cout << threads << "\t" << seconds << "\t\t" << (baseSeconds / seconds) << "\t\t"
+	   << (baseSeconds / seconds / threads) << "\t\t" << (identical ? "yes" : "NO") << "\n";
+
+      if (threads == opts.threads)
+	return seconds;
+    }
+}
+
+/***************************************************************************
+ * int checkOrder(const simulationOptions &)
+ * Date: 17 October 2026
+ * Description: checks that no scheduler depends on what ran before it or
+ *next to it (--check-order). Experiments of the sweep are generated at the
+ *first, middle and last request size, and every registered scheduler is run
+ *on each one three times: in registry order, in reverse order, and all at
+ *once on a thread each against the same queues. The averages and the
+ *histograms must match bit for bit.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  seed, sizes, nstep, generator and sorter
+ * checkOrder O/P int  status code, 1 if any scheduler gave a different result
+ **************************************************************************/
+int checkOrder(const simulationOptions &opts)
+{
+  const int sizes[] = { opts.firstSize, (opts.firstSize + opts.lastSize) / 2, opts.lastSize };
+  int experiments = min(opts.experiments, CHECK_EXPERIMENTS);
+  workerArena arena;
+  rngStream rng;
+  vector<double> result(3 * NUM_SCHEDULERS); // [forward, reverse, concurrent][scheduler]
+  vector<latencyHistogram> histogram(3 * NUM_SCHEDULERS);
+  vector<pathScratch> scratch(NUM_SCHEDULERS); // one per scheduler, since the last pass runs them all at once
+  vector<long> runs(NUM_SCHEDULERS, 0), reverseDiffer(NUM_SCHEDULERS, 0), concurrentDiffer(NUM_SCHEDULERS, 0);
+  bool same = true;
+
+  auto run = [&](int pass, int i) {
+    const requestQueue &queue = SCHEDULERS[i].sorted ? arena.sorted : arena.arrival;
+
+    clearHistogram(histogram[pass * NUM_SCHEDULERS + i]);
+    result[pass * NUM_SCHEDULERS + i] = SCHEDULERS[i].run(queue, opts.nstep, &histogram[pass * NUM_SCHEDULERS + i], scratch[i]);
+  };
+
+  reserveArena(arena, opts.lastSize);
+  for (int size : sizes)
+    {
+      for (int experiment = 0; experiment < experiments; experiment++)
+	{
+	  vector<thread> workers;
+
+	  seedStream(rng, opts.seed, experiment, size);
+	  opts.generator(arena.request.data(), size, rng, arena);
+	  opts.sorter(arena.request.data(), size, arena.order.data(), arena);
+	  loadQueue(arena.arrival, arena.request.data(), size);
+	  loadSortedQueue(arena.sorted, arena.request.data(), arena.order.data(), size);
+
+	  for (int i = 0; i < NUM_SCHEDULERS; i++)
+	    run(0, i);
+	  for (int i = NUM_SCHEDULERS - 1; i >= 0; i--)
+	    run(1, i);
+	  for (int i = 0; i < NUM_SCHEDULERS; i++)
+	    workers.push_back(thread(run, 2, i));
+	  for (size_t i = 0; i < workers.size(); i++)
+	    workers[i].join();
+
+	  for (int i = 0; i < NUM_SCHEDULERS; i++)
+	    {
+	      for (int pass = 1; pass < 3; pass++)
+		{
+		  bool match = memcmp(&result[i], &result[pass * NUM_SCHEDULERS + i], sizeof(double)) == 0 &&
+			       memcmp(&histogram[i], &histogram[pass * NUM_SCHEDULERS + i], sizeof(latencyHistogram)) == 0;
+
+		  (pass == 1 ? reverseDiffer : concurrentDiffer)[i] += !match;
+		  same &= match;
+		}
+	      runs[i]++;
+	    }
+	}
+    }
+
+  cout << "Scheduler\tRuns\tReverse order\tConcurrent\n";
+  for (int i = 0; i < NUM_SCHEDULERS; i++)
+    {
+      cout << SCHEDULERS[i].label << "\t\t" << runs[i] << "\t"
+	   << (reverseDiffer[i] == 0 ? "same" : to_string(reverseDiffer[i]) + " differ") << "\t\t"
+	   << (concurrentDiffer[i] == 0 ? "same" : to_string(concurrentDiffer[i]) + " differ") << "\n";
+    }
+  return same ? 0 : 1;
+}
+
+/***************************************************************************
+ * double sumDistance(int, double)
+ * Date: 17 October 2026
+ * Description: sum of |s - c| over the whole numbers s = 0 ... count - 1,
+ *in closed form.
+ *
+ * Parameters:
+ * count I/P int  number of whole numbers summed over
+ * c I/P double  point the distances are measured from
+ * sumDistance O/P double  sum of the distances
+ **************************************************************************/
+double sumDistance(int count, double c)
+{
+  double below = min((double)count, max(0.0, ceil(c))); // whole numbers below c
+  double all = (double)count * (count - 1) / 2; // sum of every whole number counted
+
+  return (below * c - below * (below - 1) / 2) + ((all - below * (below - 1) / 2) - (count - below) * c);
+}
+
+/***************************************************************************
+ * double expectedRotation(double)
+ * Date: 17 October 2026
+ * Description: rotational latency of a step averaged over every requested
+ *sector of the track, when the head gets to the requested track having passed
+ *arrival (the sector it was on plus the sectors passed during the seek).
+ *Takes the same branches as stepCost(), including checkSector() adding a
+ *rotation to anything below 12000, so it is the mean of exactly what the
+ *schedulers add up.
+ *
+ * Parameters:
+ * arrival I/P double  current sector plus the sectors passed while seeking
+ * expectedRotation O/P double  average rotational latency in milliseconds
+ **************************************************************************/
+double expectedRotation(double arrival)
+{
+  const int sectors = activeDisk.zoneSectors[0]; // sectors on every track, the mode needs an unzoned disk
+  double currentSector = checkSector(arrival, sectors);
+  double before = min((double)sectors, max(0.0, ceil(currentSector))); // requested sectors below currentSector
+  double all = (double)sectors * (sectors - 1) / 2; // sum of every sector
+
+  // below currentSector the wait is |sectors - (currentSector - sector)|, at or above it sector - currentSector
+  double total = sumDistance((int)before, currentSector - sectors);
+  total += (all - before * (before - 1) / 2) - (sectors - before) * currentSector;
+
+  return (total * activeDisk.sectorMs[0] / sectors);
+}
+
+/***************************************************************************
+ * void buildAnalyticModel(analyticModel &)
+ * Date: 17 October 2026
+ * Description: works out the tables of the analytic mode from the cost
+ *model: the mean rotational latency of a step of every track distance
+ *(sectors are uniform and independent of the tracks, so that is all the
+ *rotation depends on), the summed seek of every step within each half of
+ *the disk, and the mean first and later step of fifo, where every point is
+ *an independent uniform draw. Seeks go through stepCost() so the snapback
+ *is taken exactly where the schedulers take it.
+ *
+ * Parameters:
+ * model O/P analyticModel&  tables of the analytic mode
+ **************************************************************************/
+void buildAnalyticModel(analyticModel &model)
+{
+  const int tracks = activeDisk.tracks, start = activeDisk.startTrack, sectors = activeDisk.zoneSectors[0];
+  double seek, rotation;
+
+  model.rotation.assign(tracks, 0);
+  for (int k = 0; k < tracks; k++)
+    {
+      double passed = (activeDisk.seekTime(k) / activeDisk.sectorMs[0]); // sectors passed while seeking, as stepCost works it out
+      double total = 0;
+
+      for (int currentSector = 0; currentSector < sectors; currentSector++)
+	{
+	  total += expectedRotation(currentSector + passed);
+	}
+      model.rotation[k] = total / sectors;
+    }
+
+  for (int control = 0; control < NUM_CONTROLS; control++)
+    {
+      model.seek[control].assign(tracks, 0);
+    }
+  model.fifoSeek = 0;
+  for (int from = 0; from < tracks; from++)
+    {
+      for (int to = 0; to < tracks; to++)
+	{
+	  stepCost(from, 0, to, 0, seek, rotation);
+	  model.fifoSeek += seek;
+
+	  // steps between two tracks on the same half of the disk, see controlPaths
+	  if ((from < start) == (to < start) && from != to)
+	    {
+	      int control = 2 * (from >= start) + (to < from);
+	      model.seek[control][abs(from - to)] += seek;
+	    }
+	}
+    }
+  model.fifoSeek /= (double)tracks * tracks;
+
+  // track distance between two independent points is k with probability 2 (5000 - k) / 5000^2, 0 with 1 / 5000
+  model.fifoRotation = model.rotation[0] / tracks;
+  for (int k = 1; k < tracks; k++)
+    {
+      model.fifoRotation += model.rotation[k] * 2.0 * (tracks - k) / ((double)tracks * tracks);
+    }
+
+  // the first step leaves from the start track, sector 0
+  model.fifoFirst = 0;
+  for (int track = 0; track < tracks; track++)
+    {
+      stepCost(start, 0, track, 0, seek, rotation);
+      model.fifoFirst += seek + expectedRotation(activeDisk.seekTime(abs(start - track)) / activeDisk.sectorMs[0]);
+    }
+  model.fifoFirst /= tracks;
+}
+
+/***************************************************************************
+ * double controlMean(const analyticModel &, int, int)
+ * Date: 17 October 2026
+ * Description: expected value of a control path (see controlPaths) over
+ *requests of size uniform points. Neighbouring points of the sorted
+ *request are tracks v and v + k with no point between them with
+ *probability (1 - q)^n - 2 (1 - q - p)^n + (1 - q - 2p)^n, where p = 1/5000
+ *and q = (k - 1)/5000 (inclusion-exclusion over v and v + k being empty),
+ *the same for every v. Points on the same track are the rest of the
+ *request less the distinct tracks. Points are treated as independent; the
+ *generators redraw a point with probability under 1/60000, which is far
+ *inside the confidence intervals.
+ *
+ * Parameters:
+ * model I/P const analyticModel&  tables of the analytic mode
+ * size I/P int  number of points in the request
+ * control I/P int  control path (see controlPaths)
+ * controlMean O/P double  expected time of the path divided by size
+ **************************************************************************/
+double controlMean(const analyticModel &model, int size, int control)
+{
+  int length = (control < 2) ? activeDisk.startTrack : activeDisk.tracks - activeDisk.startTrack; // tracks in the half of the disk
+  double p = 1.0 / activeDisk.tracks;
+  double total = 0;
+
+  for (int k = 1; k < length; k++)
+    {
+      double q = (k - 1) * p;
+      double neighbours = pow(1 - q, size) - 2 * pow(1 - q - p, size) + pow(1 - q - 2 * p, size);
+
+      total += neighbours * (model.seek[control][k] + (length - k) * model.rotation[k]);
+    }
+
+  // points that share a track are stepped between with no seek
+  double repeats = size * length * p - length * (1 - pow(1 - p, size));
+  total += repeats * model.rotation[0];
+
+  return (total / size);
+}
+
+/***************************************************************************
+ * void controlPaths(const requestQueue &, double[])
+ * Date: 17 October 2026
+ * Description: times of the control paths of a sorted request, the control
+ *variates of the analytic mode. The request is split where the sweeps
+ *start (track 2499), and each half is walked through once upwards and
+ *once downwards in sorted order, giving 4 paths: 0 up the lower half, 1
+ *down it, 2 up the upper half, 3 down it. look is path 2, the turn and
+ *path 1; clook is path 2, the jump and path 0; scan and cscan add the edge
+ *stops. The expected value of every path is known (controlMean), so the
+ *difference between a scheduler and its paths is all that is left to
+ *estimate, and that varies much less than the scheduler does.
+ *
+ * Parameters:
+ * sorted I/P const requestQueue&  request sorted by track
+ * control O/P double[]  time of each control path divided by the request size
+ **************************************************************************/
+void controlPaths(const requestQueue &sorted, double control[])
+{
+  int split = firstAtOrAbove(sorted, activeDisk.startTrack);
+  int first[2] = { 0, split }; // first point of each half
+  int last[2] = { split - 1, sorted.size - 1 }; // last point of each half
+  double seek, rotation;
+
+  for (int half = 0; half < 2; half++)
+    {
+      double up = 0, down = 0;
+
+      for (int i = first[half]; i < last[half]; i++)
+	{
+	  stepCost(sorted.track[i], sorted.sector[i], sorted.track[i + 1], sorted.sector[i + 1], seek, rotation);
+	  up += seek + rotation;
+	}
+      for (int i = last[half]; i > first[half]; i--)
+	{
+	  stepCost(sorted.track[i], sorted.sector[i], sorted.track[i - 1], sorted.sector[i - 1], seek, rotation);
+	  down += seek + rotation;
+	}
+      control[2 * half] = up / sorted.size;
+      control[2 * half + 1] = down / sorted.size;
+    }
+}
+
+/***************************************************************************
+ * void controlEstimate(const vector<double> &, const vector<double> &, const double[], double &, double &)
+ * Date: 17 October 2026
+ * Description: control variate estimate of a scheduler's mean. Fits the
+ *scheduler's results against the control paths by least squares (Gaussian
+ *elimination on the normal equations, dropping paths that do not vary,
+ *like an empty half of the disk) and corrects the sample mean by how far
+ *the paths' sample means are from their expected values. The confidence
+ *interval comes from the spread of what the fit leaves over.
+ *
+ * Parameters:
+ * result I/P const vector<double>&  scheduler result of each sample
+ * control I/P const vector<double>&  control paths of each sample [sample][path]
+ * expected I/P const double[]  expected value of each control path
+ * mean O/P double&  estimated mean
+ * halfWidth O/P double&  half width of the 95% confidence interval
+ **************************************************************************/
+void controlEstimate(const vector<double> &result, const vector<double> &control, const double expected[],
+		     double &mean, double &halfWidth)
+{
+  int samples = result.size();
+  double resultMean = 0, pathMean[NUM_CONTROLS] = { 0 };
+  double a[NUM_CONTROLS][NUM_CONTROLS + 1] = { { 0 } }; // normal equations, right hand side in the last column
+  double beta[NUM_CONTROLS] = { 0 };
+  bool used[NUM_CONTROLS] = { false };
+  int fitted = 0;
+
+  for (int i = 0; i < samples; i++)
+    {
+      resultMean += result[i] / samples;
+      for (int c = 0; c < NUM_CONTROLS; c++)
+	pathMean[c] += control[i * NUM_CONTROLS + c] / samples;
+    }
+  for (int i = 0; i < samples; i++)
+    {
+      for (int r = 0; r < NUM_CONTROLS; r++)
+	{
+	  double yr = control[i * NUM_CONTROLS + r] - pathMean[r];
+
+	  for (int c = 0; c < NUM_CONTROLS; c++)
+	    a[r][c] += yr * (control[i * NUM_CONTROLS + c] - pathMean[c]);
+	  a[r][NUM_CONTROLS] += yr * (result[i] - resultMean);
+	}
+    }
+
+  // elimination with partial pivoting, leaving out paths that add nothing to the fit
+  int row[NUM_CONTROLS]; // row pivoted on for each path
+  double scale = 0;
+  for (int c = 0; c < NUM_CONTROLS; c++)
+    scale = max(scale, a[c][c]);
+  for (int c = 0, r = 0; c < NUM_CONTROLS && r < NUM_CONTROLS; c++)
+    {
+      int pivot = r;
+      for (int i = r + 1; i < NUM_CONTROLS; i++)
+	{
+	  if (abs(a[i][c]) > abs(a[pivot][c]))
+	    pivot = i;
+	}
+      if (abs(a[pivot][c]) <= 1e-12 * scale || samples - 2 - fitted <= 0)
+	continue;
+      swap(a[r], a[pivot]);
+      for (int i = 0; i < NUM_CONTROLS; i++)
+	{
+	  if (i == r)
+	    continue;
+	  double factor = a[i][c] / a[r][c];
+	  for (int j = c; j <= NUM_CONTROLS; j++)
+	    a[i][j] -= factor * a[r][j];
+	}
+      row[c] = r++;
+      used[c] = true;
+      fitted++;
+    }
+  for (int c = 0; c < NUM_CONTROLS; c++)
+    {
+      if (used[c])
+	beta[c] = a[row[c]][NUM_CONTROLS] / a[row[c]][c];
+    }
+
+  mean = resultMean;
+  for (int c = 0; c < NUM_CONTROLS; c++)
+    mean -= beta[c] * (pathMean[c] - expected[c]);
+
+  double residual = 0;
+  for (int i = 0; i < samples; i++)
+    {
+      double e = result[i] - resultMean;
+      for (int c = 0; c < NUM_CONTROLS; c++)
+	e -= beta[c] * (control[i * NUM_CONTROLS + c] - pathMean[c]);
+      residual += e * e;
+    }
+  halfWidth = CONFIDENCE_Z * sqrt(residual / max(1, samples - 1 - fitted) / samples);
+}
+
+/***************************************************************************
+ * void analyticWorker(analyticState &)
+ * Date: 17 October 2026
+ * Description: body of a worker thread of the analytic mode. Takes request
+ *sizes until none are left and estimates every scheduler at that size:
+ *fifo straight from the model, the others from opts.samples experiments
+ *(the first experiments of the sweep, seeded the same way) corrected with
+ *the control paths. Each size only depends on its own experiments, so the
+ *results are the same for any number of threads.
+ *
+ * Parameters:
+ * state I/O analyticState&  shared state of the analytic mode
+ **************************************************************************/
+void analyticWorker(analyticState &state)
+{
+  const simulationOptions &opts = *state.opts;
+  int count = opts.schedulers.size();
+  int samples = opts.samples;
+  workerArena arena;
+  requestQueue &arrival = arena.arrival, &sorted = arena.sorted;
+  vector<double> result((size_t)count * samples), control((size_t)samples * NUM_CONTROLS);
+  vector<double> column(samples);
+  double expected[NUM_CONTROLS];
+  rngStream rng;
+  int index;
+
+  reserveArena(arena, opts.lastSize);
+  while ((index = state.nextSize.fetch_add(1)) <= opts.lastSize - opts.firstSize)
+    {
+      int size = opts.firstSize + index;
+
+      for (int c = 0; c < NUM_CONTROLS; c++)
+	expected[c] = controlMean(*state.model, size, c);
+
+      for (int experiment = 0; experiment < samples; experiment++)
+	{
+	  seedStream(rng, opts.seed, experiment, size);
+	  opts.generator(arena.request.data(), size, rng, arena);
+	  opts.sorter(arena.request.data(), size, arena.order.data(), arena);
+	  loadQueue(arrival, arena.request.data(), size);
+	  loadSortedQueue(sorted, arena.request.data(), arena.order.data(), size);
+
+	  controlPaths(sorted, &control[(size_t)experiment * NUM_CONTROLS]);
+	  for (int alg = 0; alg < count; alg++)
+	    {
+	      const schedulerInfo *scheduler = opts.schedulers[alg];
+	      const requestQueue &queue = scheduler->sorted ? sorted : arrival;
+
+	      if (scheduler->run == fifo)
+		continue; // worked out exactly below
+	      result[(size_t)alg * samples + experiment] = scheduler->run(queue, opts.nstep, NULL, arena.path);
+	    }
+	}
+
+      for (int alg = 0; alg < count; alg++)
+	{
+	  double &mean = state.mean[(size_t)index * count + alg];
+	  double &halfWidth = state.halfWidth[(size_t)index * count + alg];
+
+	  if (opts.schedulers[alg]->run == fifo)
+	    {
+	      mean = (state.model->fifoFirst + (size - 1) * (state.model->fifoSeek + state.model->fifoRotation)) / size;
+	      halfWidth = 0;
+	      continue;
+	    }
+	  copy(result.begin() + (size_t)alg * samples, result.begin() + (size_t)(alg + 1) * samples, column.begin());
+	  controlEstimate(column, control, expected, mean, halfWidth);
+	}
+    }
+}
+
+/***************************************************************************
+ * int runAnalytic(const simulationOptions &)
+ * Date: 17 October 2026
+ * Description: analytic mode (--analytic). Works out the expected average
+ *seek time of every selected scheduler and request size of the sweep from the
+ *cost model instead of running opts.experiments experiments: fifo in
+ *closed form, the others as a small Monte Carlo run (--samples
+ *experiments per size) with the sorted request's control paths as control
+ *variates, whose expected values are closed form. Prints and writes to
+ *the .csv the estimates with their 95% confidence intervals (0 for fifo,
+ *which is exact).
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  schedulers, samples, seed and threads
+ * runAnalytic O/P int  status code, 1 if the disk is zoned
+ **************************************************************************/
+int runAnalytic(const simulationOptions &opts)
+{
+  int count = opts.schedulers.size();
+  analyticModel model;
+  analyticState state;
+  vector<thread> workers;
+  resultsSink results;
+
+  if (activeDisk.zones > 1)
+    {
+      cerr << "--analytic needs a disk with the same sectors on every track\n";
+      return 1;
+    }
+  if (opts.generator == workloadRequest)
+    {
+      cerr << "--analytic needs uniform requests, its control variates are worked out for them\n";
+      return 1;
+    }
+
+  auto start = chrono::steady_clock::now();
+
+  buildAnalyticModel(model);
+  state.opts = &opts;
+  state.model = &model;
+  state.nextSize = 0;
+  state.mean.assign((size_t)(opts.lastSize - opts.firstSize + 1) * count, 0);
+  state.halfWidth.assign((size_t)(opts.lastSize - opts.firstSize + 1) * count, 0);
+
+  for (int i = 0; i < opts.threads; i++)
+    {
+      workers.push_back(thread(analyticWorker, ref(state)));
+    }
+  for (size_t i = 0; i < workers.size(); i++)
+    {
+      workers[i].join();
+    }
+
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+  vector<string> names(1, "Size");
+  string types = "i";
+  vector<double> row;
+
+  cout << "Size:";
+  for (int alg = 0; alg < count; alg++)
+    {
+      cout << "\t" << opts.schedulers[alg]->label << "\t\t+/-" << (alg + 1 < count ? "\t" : "\n");
+      names.push_back(opts.schedulers[alg]->label);
+      names.push_back(opts.schedulers[alg]->label + string(" ci"));
+      types += "dd";
+    }
+  if (!openSink(results, opts.results, names, types))
+    return 1;
+
+  for (int i = 0; i <= opts.lastSize - opts.firstSize; i++)
+    {
+      row.assign(1, i + opts.firstSize);
+      cout << i + opts.firstSize;
+      for (int alg = 0; alg < count; alg++)
+	{
+	  cout << "\t" << state.mean[i * count + alg] << "\t" << state.halfWidth[i * count + alg]
+	       << (alg + 1 < count ? "\t" : "");
+	  row.push_back(state.mean[i * count + alg]);
+	  row.push_back(state.halfWidth[i * count + alg]);
+	}
+      cout << "\n";
+      sinkRows(results, row.data(), 1);
+    }
+
+  cout << "fifo step: seek " << model.fifoSeek << " ms, rotation " << model.fifoRotation << " ms, first step "
+       << model.fifoFirst << " ms\n";
+  cout << opts.samples << " samples per size in " << elapsed.count() << " s\n";
+
+  return closeSink(results) ? 0 : 1;
+}
+
+/***************************************************************************
+ * void benchSstf()
+ * Date: 17 October 2026
+ * Description: times sstf() against the original sstfLinear() for queue
+ *sizes from 500 up to 10^6 and checks that both give the same result. The
+ *linear version is only run up to 20000 requests since it is O(n^2).
+ *Queues are random (duplicates allowed) and sorted with sortRequest().
+ **************************************************************************/
+void benchSstf()
+{
+  const int sizes[] = { 500, 1000, 10000, 20000, 100000, 1000000 };
+  rngStream rng;
+
+  cout << "Size\tLinear ms\tIndexed ms\tSpeedup\tMatch\n";
+  for (int size : sizes)
+    {
+      vector<point> input(size), sorted(size);
+      vector<point> work;
+      vector<uint32_t> order(size);
+      workerArena arena;
+      requestQueue queue;
+
+      seedStream(rng, 1, 0, size);
+      for (int i = 0; i < size; i++)
+	{
+	  input[i] = randomPoint(rng);
+	}
+      sortRequest(input.data(), size, order.data(), arena);
+      for (int i = 0; i < size; i++)
+	{
+	  sorted[i] = input[order[i]];
+	}
+
+      // repeat small sizes so the timings are not just clock noise
+      int repeat = max(1, 20000 / size);
+      double linearMs = 0, indexedMs = 0, linearResult = 0, indexedResult = 0;
+
+      auto start = chrono::steady_clock::now();
+      for (int r = 0; r < repeat; r++)
+	{
+	  loadQueue(queue, sorted.data(), size);
+	  indexedResult = sstf(queue, 0, NULL, arena.path);
+	}
+      indexedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / repeat;
+
+      if (size <= 20000)
+	{
+	  start = chrono::steady_clock::now();
+	  for (int r = 0; r < repeat; r++)
+	    {
+	      work = sorted;
+	      linearResult = sstfLinear(work.data(), size);
+	    }
+	  linearMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / repeat;
+
+	  cout << size << "\t" << linearMs << "\t\t" << indexedMs << "\t\t" << (linearMs / indexedMs)
+	       << "\t" << (linearResult == indexedResult ? "yes" : "NO") << "\n";
+	}
+      else
+	{
+	  cout << size << "\t-\t\t" << indexedMs << "\t\t-\t-\n";
+	}
+    }
+}
+
+/***************************************************************************
+ * void benchSort()
+ * Date: 17 October 2026
+ * Description: times each sorting stage at 500, 10^4 and 10^6 requests and
+ *checks it gives exactly the same order as bubbleSortRequest(). Bubble sort
+ *is skipped above 10^4 requests (and the other sorters are compared against
+ *stableSortRequest() there instead).
+ **************************************************************************/
+void benchSort()
+{
+  const int sizes[] = { 500, 10000, 1000000 };
+  const char *names[] = { "bubble", "counting", "std" };
+  rngStream rng;
+
+  cout << "Size\tSorter\t\tms\t\tSpeedup\tSame order\n";
+  for (int size : sizes)
+    {
+      vector<point> input(size);
+      vector<uint32_t> expected;
+      vector<uint32_t> work(size);
+      workerArena arena;
+      double bubbleMs = 0;
+
+      seedStream(rng, 1, 0, size);
+      for (int i = 0; i < size; i++)
+	{
+	  input[i] = randomPoint(rng);
+	}
+
+      for (const char *name : names)
+	{
+	  sortFunction sorter = findSorter(name);
+	  int repeat = max(1, 100000 / size);
+
+	  if (sorter == bubbleSortRequest && size > 10000)
+	    {
+	      cout << size << "\t" << name << "\t\t-\t\t-\t-\n";
+	      continue;
+	    }
+
+	  auto start = chrono::steady_clock::now();
+	  for (int r = 0; r < repeat; r++)
+	    {
+	      sorter(input.data(), size, work.data(), arena);
+	    }
+	  double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / repeat;
+
+	  if (expected.empty())
+	    {
+	      // the first sorter run sets the order every other sorter must match
+	      expected = work;
+	      if (sorter != bubbleSortRequest)
+		stableSortRequest(input.data(), size, expected.data(), arena);
+	    }
+	  if (sorter == bubbleSortRequest)
+	    bubbleMs = ms;
+
+	  bool same = (work == expected);
+
+	  cout << size << "\t" << name << "\t" << (strlen(name) < 8 ? "\t" : "") << ms << "\t\t";
+	  if (bubbleMs > 0)
+	    cout << (bubbleMs / ms);
+	  else
+	    cout << "-";
+	  cout << "\t" << (same ? "yes" : "NO") << "\n";
+	}
+    }
+}
+
+/***************************************************************************
+ * void benchKernel()
+ * Date: 17 October 2026
+ * Description: times every version of stepCosts() the program was compiled
+ *with on random paths of 500 to 10^6 points, and checks each gives the same
+ *total, bit for bit, as servicing the path one point at a time with
+ *serviceStep().
+ **************************************************************************/
+void benchKernel()
+{
+  const int sizes[] = { 500, 1000, 100000, 1000000 };
+  const char *names[] = { "scalar", "avx2", "avx512" };
+  void (*kernels[])(const double[], const double[], int, double[], double[]) = {
+    stepCostsScalar,
+#ifdef __AVX2__
+    stepCostsAvx2,
+#else
+    NULL,
+#endif
+#ifdef __AVX512F__
+    stepCostsAvx512,
+#else
+    NULL,
+#endif
+  };
+  rngStream rng;
+
+  cout << "Size\tKernel\tms\t\tSpeedup\tSame total\n";
+  for (int size : sizes)
+    {
+      vector<double> track(size), sector(size), seek(size), rotation(size);
+      double expected = 0, currentTrack = activeDisk.startTrack, currentSector = 0, scalarMs = 0;
+
+      seedStream(rng, 1, 0, size);
+      for (int i = 0; i < size; i++)
+	{
+	  point where = randomPoint(rng);
+
+	  track[i] = where.track;
+	  sector[i] = where.sector;
+	  serviceStep(currentTrack, currentSector, track[i], sector[i], expected);
+	}
+
+      for (int k = 0; k < 3; k++)
+	{
+	  if (kernels[k] == NULL)
+	    continue;
+
+	  int repeat = max(1, 1000000 / size);
+	  auto start = chrono::steady_clock::now();
+	  for (int r = 0; r < repeat; r++)
+	    {
+	      kernels[k](track.data(), sector.data(), size, seek.data(), rotation.data());
+	    }
+	  double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / repeat;
+	  if (k == 0)
+	    scalarMs = ms;
+
+	  double totalTime = 0;
+	  for (int i = 0; i < size; i++)
+	    {
+	      totalTime += seek[i];
+	      totalTime += rotation[i];
+	    }
+
+	  cout << size << "\t" << names[k] << "\t" << ms << "\t" << (scalarMs / ms) << "\t"
+	       << (totalTime == expected ? "yes" : "NO") << "\n";
+	}
+    }
+}
+
+/***************************************************************************
+ * void benchInterleave()
+ * Date: 17 October 2026
+ * Description: times every scheduler with a lane (see schedulerInfo) on
+ *MAX_INTERLEAVE queues of 10^5 and 10^6 random points on one core, back to
+ *back with run() and through interleaveLanes 1, 2, 4 and 8 at a time, and
+ *checks every width gives the same averages bit for bit as back to back.
+ *Prints the time per experiment and the throughput against back to back.
+ **************************************************************************/
+void benchInterleave()
+{
+  const int sizes[] = { 100000, 1000000 };
+  const int widths[] = { 1, 2, 4, 8 };
+  rngStream rng;
+
+  cout << "Size	Scheduler	Width	ms		Speedup	Same\n";
+  for (int size : sizes)
+    {
+      workerArena arena;
+      vector<point> input(size);
+      requestQueue *sorted[MAX_INTERLEAVE]; // queue of every experiment
+      pathScratch *path[MAX_INTERLEAVE]; // scratch of every experiment
+      schedulerLane lane[MAX_INTERLEAVE];
+      double expected[MAX_INTERLEAVE]; // averages back to back
+
+      reserveArena(arena, size);
+      reserveLanes(arena, MAX_INTERLEAVE, size);
+      for (int e = 0; e < MAX_INTERLEAVE; e++)
+	{
+	  sorted[e] = (e == 0) ? &arena.sorted : &arena.lanes[e - 1].sorted;
+	  path[e] = (e == 0) ? &arena.path : &arena.lanes[e - 1].path;
+	  seedStream(rng, 1, e, size);
+	  for (int i = 0; i < size; i++)
+	    {
+	      input[i] = randomPoint(rng);
+	    }
+	  stableSortRequest(input.data(), size, arena.order.data(), arena);
+	  loadSortedQueue(*sorted[e], input.data(), arena.order.data(), size);
+	}
+
+      for (int i = 0; i < NUM_SCHEDULERS; i++)
+	{
+	  const schedulerInfo &scheduler = SCHEDULERS[i];
+	  int repeat = max(1, 2000000 / size);
+
+	  if (scheduler.lane == NULL || scheduler.online == ONLINE_FSCAN) // fscan is scan here
+	    continue;
+
+	  auto start = chrono::steady_clock::now();
+	  for (int r = 0; r < repeat; r++)
+	    {
+	      for (int e = 0; e < MAX_INTERLEAVE; e++)
+		{
+		  expected[e] = scheduler.run(*sorted[e], 0, NULL, *path[e]);
+		}
+	    }
+	  double backMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / repeat
+			  / MAX_INTERLEAVE;
+
+	  cout << size << "\t" << scheduler.name << "\t\t-\t" << backMs << "\t\t1\t-\n";
+	  for (int width : widths)
+	    {
+	      bool same = true;
+
+	      start = chrono::steady_clock::now();
+	      for (int r = 0; r < repeat; r++)
+		{
+		  for (int group = 0; group < MAX_INTERLEAVE; group += width)
+		    {
+		      for (int w = 0; w < width; w++)
+			{
+			  startLane(lane[w], *sorted[group + w], NULL, *path[group + w]);
+			}
+		      interleaveLanes(scheduler.lane, lane, width);
+		      for (int w = 0; w < width; w++)
+			{
+			  same &= (lane[w].average == expected[group + w]);
+			}
+		    }
+		}
+	      double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / repeat
+			  / MAX_INTERLEAVE;
+
+	      cout << size << "\t" << scheduler.name << "\t\t" << width << "\t" << ms << "\t\t" << (backMs / ms) << "\t"
+		   << (same ? "yes" : "NO") << "\n";
+	    }
+	}
+    }
+}
+
+/***************************************************************************
+ * bool readBenchBaseline(const char *, vector<benchResult> &)
+ * Date: 17 October 2026
+ * Description: reads the name and time per iteration of every case of a
+ *JSON report written by writeBenchJson, one case per line. Only that
+ *layout is understood, it is not a general JSON reader.
+ *
+ * Parameters:
+ * path I/P const char*  report to be read
+ * baseline O/P vector<benchResult>&  cases of the report (name and ns only)
+ * readBenchBaseline O/P bool  false if the file could not be opened
+ **************************************************************************/
+bool readBenchBaseline(const char *path, vector<benchResult> &baseline)
+{
+  ifstream in(path);
+  string line;
+
+  if (!in)
+    {
+      cerr << "could not open " << path << "\n";
+      return false;
+    }
+
+  baseline.clear();
+  while (getline(in, line))
+    {
+      size_t name = line.find("{\"name\": \"");
+      size_t time = line.find("\"real_time\": ");
+
+      if (name == string::npos || time == string::npos)
+	continue;
+
+      benchResult result = benchResult();
+      name += 10;
+      result.name = line.substr(name, line.find('"', name) - name);
+      result.ns = strtod(line.c_str() + time + 13, NULL);
+      baseline.push_back(result);
+    }
+  return true;
+}
+
+/***************************************************************************
+ * bool writeBenchJson(const char *, const simulationOptions &, const vector<benchResult> &)
+ * Date: 17 October 2026
+ * Description: writes the results of the benchmark suite as JSON, laid out
+ *like Google Benchmark's reports (a context and a list of benchmarks with
+ *real_time in nanoseconds per iteration and items_per_second), one case
+ *per line so readBenchBaseline can read it back.
+ *
+ * Parameters:
+ * path I/P const char*  file to be written
+ * opts I/P const simulationOptions&  options of the run
+ * results I/P const vector<benchResult>&  every case that ran
+ * writeBenchJson O/P bool  false if the file could not be written
+ **************************************************************************/
+bool writeBenchJson(const char *path, const simulationOptions &opts, const vector<benchResult> &results)
+{
+  ofstream out(path);
+
+  out.precision(10);
+  out << "{\n";
+  outputJsonContext(out, opts);
+  out << "  \"benchmarks\": [\n";
+  for (size_t i = 0; i < results.size(); i++)
+    {
+      const benchResult &result = results[i];
+
+      out << "    {\"name\": ";
+      outputJsonString(out, result.name);
+      out << ", \"iterations\": " << result.iterations << ", \"repetitions\": " << BENCH_REPETITIONS
+	  << ", \"real_time\": " << result.ns << ", \"min_time\": " << result.minNs << ", \"time_unit\": \"ns\""
+	  << ", \"items_per_second\": " << (result.ns > 0 ? result.items * 1e9 / result.ns : 0);
+      for (int c = 0; opts.perf && c < NUM_PERF_COUNTERS; c++)
+	{
+	  out << ", \"" << PERF_COUNTER_NAMES[c] << "\": " << result.counters[c];
+	}
+      out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+  out << "  ]\n}\n";
+
+  out.close();
+  if (!out)
+    {
+      cerr << "could not write " << path << "\n";
+      return false;
+    }
+  return true;
+}
+
+/***************************************************************************
+ * void benchCase(const simulationOptions &, const perfCounters &, const vector<benchResult> &, vector<benchResult> &, const string &, long, Body)
+ * Date: 17 October 2026
+ * Description: times one case of the benchmark suite, unless --bench-filter
+ *rules it out. The number of iterations is doubled (or scaled from the last
+ *try) until one batch takes at least --bench-min-ms, then BENCH_REPETITIONS
+ *batches are timed and the median and fastest time per iteration kept, so
+ *one slow batch does not move the result. Hardware counts are averaged
+ *over every timed iteration. Prints the case, and how its time compares
+ *to the same case of the baseline if there is one.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  filter and batch length
+ * perf I/P const perfCounters&  counters of this thread, if open
+ * baseline I/P const vector<benchResult>&  earlier results to compare against, may be empty
+ * results I/O vector<benchResult>&  the case is added here
+ * name I/P const string&  name of the case, kind/variant/size
+ * items I/P long  requests handled by one iteration
+ * body I/P Body  runs one iteration
+ **************************************************************************/
+template <class Body>
+void benchCase(const simulationOptions &opts, const perfCounters &perf, const vector<benchResult> &baseline,
+	       vector<benchResult> &results, const string &name, long items, Body body)
+{
+  if (opts.benchFilter != NULL && name.find(opts.benchFilter) == string::npos)
+    return;
+
+  benchResult result = benchResult();
+  long iterations = 1;
+  double batchNs[BENCH_REPETITIONS];
+  uint64_t before[NUM_PERF_COUNTERS], after[NUM_PERF_COUNTERS];
+
+  // find how many iterations make a batch of at least opts.benchMinMs
+  for (;;)
+    {
+      auto start = chrono::steady_clock::now();
+      for (long i = 0; i < iterations; i++)
+	{
+	  body();
+	}
+      double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+      if (ms >= opts.benchMinMs || iterations >= (1L << 30))
+	break;
+      if (ms <= 0)
+	iterations *= 10;
+      else
+	iterations = max(iterations * 2, min(iterations * 10, (long)(iterations * opts.benchMinMs * 1.2 / ms)));
+    }
+
+  readPerfCounters(perf, before);
+  for (int r = 0; r < BENCH_REPETITIONS; r++)
+    {
+      auto start = chrono::steady_clock::now();
+      for (long i = 0; i < iterations; i++)
+	{
+	  body();
+	}
+      batchNs[r] = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / iterations;
+    }
+  readPerfCounters(perf, after);
+  sort(batchNs, batchNs + BENCH_REPETITIONS);
+
+  result.name = name;
+  result.iterations = iterations;
+  result.ns = batchNs[BENCH_REPETITIONS / 2];
+  result.minNs = batchNs[0];
+  result.items = items;
+  for (int c = 0; c < NUM_PERF_COUNTERS; c++)
+    {
+      result.counters[c] = (double)(after[c] - before[c]) / ((double)iterations * BENCH_REPETITIONS);
+    }
+  results.push_back(result);
+
+  cout << name << string(max<size_t>(1, 32 - name.size()), ' ') << iterations << "\t\t" << result.ns << "\t\t"
+       << (result.ns > 0 ? items * 1e9 / result.ns : 0);
+  if (perf.open)
+    cout << "\t" << (result.counters[0] > 0 ? result.counters[1] / result.counters[0] : 0);
+  for (const benchResult &old : baseline)
+    {
+      if (old.name == name && old.ns > 0)
+	cout << "\t" << showpos << (100 * (result.ns / old.ns - 1)) << noshowpos << "%"
+	     << (result.ns > old.ns * BENCH_REGRESSION ? " slower" : "");
+    }
+  cout << "\n";
+}
+
+/***************************************************************************
+ * int benchSuite(const simulationOptions &)
+ * Date: 17 October 2026
+ * Description: benchmark suite (--bench). Times generating requests with
+ *each generator, each sorting stage (bubble sort only up to 10^4), loading
+ *the queues and every scheduler in the registry (satf only up to 10^5, one
+ *pass over 10^6 takes seconds), at 10^2 up to 10^6 requests. Prints nanoseconds per iteration and requests per second of
+ *every case (and instructions per cycle with --perf), writes them as JSON
+ *with --json and, with --bench-baseline, compares them to an earlier JSON
+ *report and counts the cases more than 10% slower.
+ *Inputs are drawn with the --seed stream of experiment 0, so every version
+ *times the same requests.
+ *
+ * Parameters:
+ * opts I/P const simulationOptions&  seed, nstep, filter, batch length and files
+ * benchSuite O/P int  status code, 1 if a file could not be read or written
+ **************************************************************************/
+int benchSuite(const simulationOptions &opts)
+{
+  const int sizes[] = { 100, 1000, 10000, 100000, 1000000 };
+  const char *generators[] = { "rejection", "floyd" };
+  const char *sorters[] = { "bubble", "counting", "std" };
+  vector<benchResult> baseline, results;
+  perfCounters perf;
+  rngStream rng;
+  workerArena arena;
+  volatile double sink = 0; // keeps the scheduler results alive
+
+  if (opts.benchBaseline != NULL && !readBenchBaseline(opts.benchBaseline, baseline))
+    return 1;
+  perf.open = false;
+  if (opts.perf)
+    openPerfCounters(perf);
+
+  cout << "Case" << string(28, ' ') << "Iterations\tns/iter\t\tRequests/s" << (perf.open ? "\tIPC" : "")
+       << (baseline.empty() ? "" : "\tChange") << "\n";
+  for (int size : sizes)
+    {
+      string suffix = "/" + to_string(size);
+      vector<point> input(size), work(size);
+      vector<uint32_t> order(size), workOrder(size);
+      requestQueue arrival, sorted;
+
+      seedStream(rng, opts.seed, 0, size);
+      generateRequest(input.data(), size, rng, arena);
+      sortRequest(input.data(), size, order.data(), arena);
+      loadQueue(arrival, input.data(), size);
+      loadSortedQueue(sorted, input.data(), order.data(), size);
+
+      for (const char *name : generators)
+	{
+	  generatorFunction generator = findGenerator(name);
+	  benchCase(opts, perf, baseline, results, string("generate/") + name + suffix, size,
+		    [&]() { generator(work.data(), size, rng, arena); });
+	}
+
+      for (const char *name : sorters)
+	{
+	  sortFunction sorter = findSorter(name);
+	  if (sorter == bubbleSortRequest && size > 10000)
+	    continue;
+	  benchCase(opts, perf, baseline, results, string("sort/") + name + suffix, size,
+		    [&]() { sorter(input.data(), size, workOrder.data(), arena); });
+	}
+
+      benchCase(opts, perf, baseline, results, "load" + suffix, 2 * size, [&]() {
+	loadQueue(arrival, input.data(), size);
+	loadSortedQueue(sorted, input.data(), order.data(), size);
+      });
+
+      for (int i = 0; i < NUM_SCHEDULERS; i++)
+	{
+	  const schedulerInfo &scheduler = SCHEDULERS[i];
+	  const requestQueue &queue = scheduler.sorted ? sorted : arrival;
+
+	  if (scheduler.run == satf && size > 100000)
+	    continue;
+	  benchCase(opts, perf, baseline, results, string("schedule/") + scheduler.name + suffix, size,
+		    [&]() { sink = sink + scheduler.run(queue, opts.nstep, NULL, arena.path); });
+	}
+    }
+  closePerfCounters(perf);
+
+  if (!baseline.empty())
+    {
+      int slower = 0, compared = 0;
+
+      for (const benchResult &result : results)
+	{
+	  for (const benchResult &old : baseline)
+	    {
+	      if (old.name == result.name && old.ns > 0)
+		{
+		  compared++;
+		  slower += (result.ns > old.ns * BENCH_REGRESSION);
+		}
+	    }
+	}
+      cout << slower << " of " << compared << " cases more than " << (100 * (BENCH_REGRESSION - 1))
+	   << "% slower than " << opts.benchBaseline << ".\n";
+    }
+
+  if (opts.json != NULL && !writeBenchJson(opts.json, opts, results))
+    return 1;
+  return 0;
+}
+
+/***************************************************************************
+ * bool parseOptions(int, char *[], simulationOptions &)
+ * Date: 17 October 2026
+ * Description: reads the command line options into opts, printing usage
+ *and returning false if an option is not recognized. Loads the disk model
+ *into activeDisk last, then checks the array of --raid fits it.
+ *
+ * Parameters:
+ * argc I/P int  number of command line arguments
+ * argv I/P char*[]  command line arguments
+ * opts O/P simulationOptions&  parsed options
+ * parseOptions O/P bool  true if every option was understood, the disk model loaded and the array is valid
+ **************************************************************************/
+bool parseOptions(int argc, char *argv[], simulationOptions &opts)
+{
+  opts.experiments = 1000;
+  opts.firstSize = FIRST_SIZE;
+  opts.lastSize = LAST_SIZE;
+  opts.results = "diskscheduling.csv";
+  opts.raw = NULL;
+  opts.readResults = NULL;
+  opts.checkpoint = NULL;
+  opts.checkpointSeconds = 60;
+  opts.resume = false;
+  opts.shared = NULL;
+  opts.status = NULL;
+  opts.threads = max(1u, thread::hardware_concurrency());
+  opts.seed = 1;
+  opts.scaling = false;
+  opts.quiet = false;
+  opts.benchSstf = false;
+  opts.benchSort = false;
+  opts.benchKernel = false;
+  opts.benchInterleave = false;
+  opts.bench = false;
+  opts.checkOrder = false;
+  opts.checkTrace = false;
+  opts.benchFilter = NULL;
+  opts.benchMinMs = 20;
+  opts.benchBaseline = NULL;
+  opts.profile = false;
+  opts.percentiles = true;
+  opts.perf = false;
+  opts.json = NULL;
+  opts.raid = -1;
+  opts.disks = 4;
+  opts.stripeUnit = 128;
+  opts.requestSectors = 8;
+  opts.writeFraction = 0.25;
+  opts.sorter = sortRequest;
+  parseSchedulers(DEFAULT_SCHEDULERS, opts.schedulers);
+  opts.nstep = 10;
+  opts.interleave = 1;
+  opts.generator = generateRequest;
+  activeWorkload.zipf = 0;
+  activeWorkload.zones.clear();
+  activeWorkload.sequential = 0;
+  activeWorkload.duplicates = DUPLICATES_REJECT;
+  opts.trace = NULL;
+  opts.traceFormat = NULL;
+  opts.traceOut = NULL;
+  opts.window = 1000;
+  opts.lbasPerSector = 1;
+  opts.simulate = 0;
+  opts.arrival = ARRIVAL_POISSON;
+  opts.rate = 0.15;
+  opts.onMs = 100;
+  opts.offMs = 100;
+  opts.ciTarget = 0;
+  opts.minExperiments = 20;
+  opts.disk = NULL;
+  opts.analytic = false;
+  opts.samples = 40;
+  bool workload = false; // a workload option was given
+
+  for (int arg = 1; arg < argc; arg++)
+    {
+      bool hasValue = (arg + 1 < argc);
+      bool known = true;
+
+      if (strcmp(argv[arg], "--threads") == 0 && hasValue)
+	{
+	  opts.threads = max(1, atoi(argv[++arg]));
+	}
+      else if (strcmp(argv[arg], "--seed") == 0 && hasValue)
+	{
+	  opts.seed = strtoull(argv[++arg], NULL, 0);
+	}
+      else if (strcmp(argv[arg], "--experiments") == 0 && hasValue)
+	{
+	  opts.experiments = max(1, atoi(argv[++arg]));
+	}
+      else if (strcmp(argv[arg], "--sizes") == 0 && hasValue)
+	{
+	  known = (sscanf(argv[++arg], "%d-%d", &opts.firstSize, &opts.lastSize) == 2 && opts.firstSize >= 1 &&
+		   opts.lastSize >= opts.firstSize);
+	}
+      else if (strcmp(argv[arg], "--results") == 0 && hasValue)
+	{
+	  opts.results = argv[++arg];
+	}
+      else if (strcmp(argv[arg], "--raw") == 0 && hasValue)
+	{
+	  opts.raw = argv[++arg];
+	}
+      else if (strcmp(argv[arg], "--read-results") == 0 && hasValue)
+	{
+	  opts.readResults = argv[++arg];
+	}
+      else if (strcmp(argv[arg], "--checkpoint") == 0 && hasValue)
+	{
+	  opts.checkpoint = argv[++arg];
+	}
+      else if (strcmp(argv[arg], "--checkpoint-seconds") == 0 && hasValue)
+	{
+	  opts.checkpointSeconds = atof(argv[++arg]);
+	  known = (opts.checkpointSeconds >= 0);
+	}
+      else if (strcmp(argv[arg], "--resume") == 0)
+	{
+	  opts.resume = true;
+	}
+      else if (strcmp(argv[arg], "--shared") == 0 && hasValue)
+	{
+	  opts.shared = argv[++arg];
+	}
+      else if (strcmp(argv[arg], "--status") == 0 && hasValue)
+	{
+	  opts.status = argv[++arg];
+	}
+      else if (strcmp(argv[arg], "--check-order") == 0)
+	{
+	  opts.checkOrder = true;
+	}
+      else if (strcmp(argv[arg], "--check-trace") == 0)
+	{
+	  opts.checkTrace = true;
+	}
+      else if (strcmp(argv[arg], "--scaling") == 0)
+	{
+	  opts.scaling = true;
+	}
+      else if (strcmp(argv[arg], "--quiet") == 0)
+	{
+	  opts.quiet = true;
+	}
+      else if (strcmp(argv[arg], "--bench-sstf") == 0)
+	{
+	  opts.benchSstf = true;
+	}
+      else if (strcmp(argv[arg], "--bench-sort") == 0)
+	{
+	  opts.benchSort = true;
+	}
+      else if (strcmp(argv[arg], "--bench-kernel") == 0)
 	{
-	  totalTime += (trackDistance * .0008); // add 800 nanoseconds for every track crossed
+	  opts.benchKernel = true;
 	}
-      else // if snapback is faster
+      else if (strcmp(argv[arg], "--bench-interleave") == 0)
 	{
-	  totalTime += (1.5 + (currentTrack * .0008));
+	  opts.benchInterleave = true;
 	}
-
-      // hdd is spinning counter clockwise
-      currentSector += ((trackDistance * .0008) / .0005); // calculate current sector as 1 sector is passed every 500 nanoseconds
-      currentSector = checkSector(currentSector); // call to function that makes sure sector is in range
-
-      if (currentSector > request[i].sector) // if requested sector is before current sector and requires another rotation
+      else if (strcmp(argv[arg], "--bench") == 0)
 	{
-	  totalTime += abs(((12000 - (currentSector - request[i].sector)) * .0005)); // add 500 nanoseconds for every sector crossed
+	  opts.bench = true;
 	}
-      else // if requested sector is further on the track or in the correct spot
+      else if (strcmp(argv[arg], "--bench-filter") == 0 && hasValue)
 	{
-	  totalTime += abs(((currentSector - request[i].sector) * .0005)); // add 500 nanoseconds for every sector crossed
+	  opts.benchFilter = argv[++arg];
 	}
-
-      currentSector = request[i].sector; // set current sector to current request
-    } // end of fifo for loop
-
-  // return the average seek time in milliseconds
-  return (totalTime / requestSize);
-}
-
-/***************************************************************************
- * double sstf(point[], int)
- * Author: Logan Wheat
- * Date: 17 November 2019
- * Description: simulates a shortest service time first disk scheduling algorithm.
- *Calculates the total time spent seeking and then returns
- *(total time / request size) to calculate average seek time between
- *requests in milliseconds.
- *
- * Parameters:
- * request I/P point[]  array of points that will be accessed in sstf algorithm
- * requestSize I/P int  size of array of points, that way function does not exceed bounds
- **************************************************************************/
-double sstf(point request[], int requestSize)
-{
-  double totalTime = 0; // initialize total time to 0 in milliseconds
-
-  double currentTrack = 2499; // start in the middle of the track
-  double currentSector = 0; // start at sector 0
-  double trackDistance; // declare track distance as a double
-  int closestTrack; // declare closest track as an int
-  double currentClosest; // declare current closest as a double
-
-  // for loop to iterate through all request and simulate sstf
-  for (int i = 0; i < requestSize; i++)
-    {
-      currentClosest = 5000; // define current closest as the furthest possible distance
-
-      // for loop to search through sorted list for closest track
-      for (int n = 0; n < requestSize; n++)
+      else if (strcmp(argv[arg], "--bench-min-ms") == 0 && hasValue)
 	{
-	  trackDistance = abs(currentTrack - request[n].track);
+	  opts.benchMinMs = atof(argv[++arg]);
+	  known = (opts.benchMinMs > 0);
+	}
+      else if (strcmp(argv[arg], "--bench-baseline") == 0 && hasValue)
+	{
+	  opts.benchBaseline = argv[++arg];
+	}
+      else if (strcmp(argv[arg], "--profile") == 0)
+	{
+	  opts.profile = true;
+	}
+      else if (strcmp(argv[arg], "--no-percentiles") == 0)
+	{
+	  opts.percentiles = false;
+	}
+      else if (strcmp(argv[arg], "--perf") == 0)
+	{
+	  opts.perf = true;
+	}
+      else if (strcmp(argv[arg], "--json") == 0 && hasValue)
+	{
+	  opts.json = argv[++arg];
+	}
+      else if (strcmp(argv[arg], "--generator") == 0 && hasValue && findGenerator(argv[arg + 1]) != NULL)
+	{
+	  opts.generator = findGenerator(argv[++arg]);
+	}
+      else if (strcmp(argv[arg], "--zipf") == 0 && hasValue)
+	{
+	  activeWorkload.zipf = max(0.0, atof(argv[++arg]));
+	  workload = true;
+	}
+      else if (strcmp(argv[arg], "--zone") == 0 && hasValue)
+	{
+	  workloadZone zone;
 
-	  if (trackDistance < currentClosest && request[n].accessed == false) // if current location is closest and has not been accessed, save as closest
+	  if (sscanf(argv[arg + 1], "%d-%d:%lf", &zone.firstTrack, &zone.lastTrack, &zone.weight) == 3)
+	    activeWorkload.zones.push_back(zone);
+	  else
+	    known = false;
+	  arg++;
+	  workload = true;
+	}
+      else if (strcmp(argv[arg], "--sequential") == 0 && hasValue)
+	{
+	  activeWorkload.sequential = min(1.0, max(0.0, atof(argv[++arg])));
+	  workload = true;
+	}
+      else if (strcmp(argv[arg], "--duplicates") == 0 && hasValue)
+	{
+	  arg++;
+	  known = false;
+	  for (int policy = DUPLICATES_REJECT; policy <= DUPLICATES_SHIFT; policy++)
 	    {
-	      currentClosest = trackDistance; // update closest track
-	      closestTrack = n; // save index of closest track
+	      if (strcmp(argv[arg], DUPLICATE_NAMES[policy]) == 0)
+		{
+		  activeWorkload.duplicates = policy;
+		  known = true;
+		}
 	    }
-	} // end of linear search
-
-      trackDistance = currentClosest; // update track distance to reuse fifo code
-      currentTrack = request[closestTrack].track; // update current track to closest track
-      request[closestTrack].accessed = true; // update that this point has been accessed already
-
-      // determine if snapback feature should be used
-      if ((trackDistance*.0008) < (1.5 + (currentTrack * .0008))) // if snapback is not faster (slower)
+	  workload = true;
+	}
+      else if (strcmp(argv[arg], "--trace") == 0 && hasValue)
 	{
-	  totalTime += (trackDistance * .0008); // add 800 nanoseconds for every track crossed
+	  opts.trace = argv[++arg];
 	}
-      else // if snapback is faster
+      else if (strcmp(argv[arg], "--trace-format") == 0 && hasValue)
 	{
-	  totalTime += (1.5 + (currentTrack * .0008));
+	  opts.traceFormat = argv[++arg];
 	}
-
-      // hdd is spinning counter clockwise
-      currentSector += ((trackDistance * .0008) / .0005); // calculate current sector as 1 sector is passed every 500 nanoseconds
-      currentSector = checkSector(currentSector); // call to function that makes sure sector is in range
-
-      if (currentSector > request[closestTrack].sector) // if requested sector is before current sector and requires another rotation
+      else if (strcmp(argv[arg], "--trace-out") == 0 && hasValue)
 	{
-	  totalTime += abs(((12000 - (currentSector - request[closestTrack].sector)) * .0005)); // add 500 nanoseconds for every sector crossed
+	  opts.traceOut = argv[++arg];
 	}
-      else // if requested sector is further on the track or in the correct spot
+      else if (strcmp(argv[arg], "--window") == 0 && hasValue)
 	{
-	  totalTime += abs(((currentSector - request[closestTrack].sector) * .0005)); // add 500 nanoseconds for every sector crossed
+	  opts.window = max(1, atoi(argv[++arg]));
 	}
-
-      currentSector = request[closestTrack].sector; // set current sector to current request
-    } // end of sstf for loop
-
-  // return average seek time in milliseconds
-  return (totalTime / requestSize);
-}
-
-/***************************************************************************
- * double scan(point[], int)
- * Author: Logan Wheat
- * Date: 19 November 2019
- * Description: simulates a scan scheduling algorithm.
- *Calculates the total time spent seeking and then returns
- *(total time / request size) to calculate average seek time between
- *requests in milliseconds.
- *
- * Parameters:
- * request I/P point[]  array of points that will be accessed in scan algorithm
- * requestSize I/P int  size of array of points, that way function does not exceed bounds
- **************************************************************************/
-double scan(point request[], int requestSize)
-{
-  double totalTime = 0; // initialize total time to 0 in milliseconds
-
-  double currentTrack = 2499; // start in the middle of the track
-  double currentSector = 0; // start at sector 0
-  double trackDistance; // declare track distance as a double
-  int closestTrack; // declare closest track as an int
-  double currentClosest; // declare current closest as a double
-
-  currentClosest = 5000; // define current closest as the furthest possible distance
-
-  // for loop to search through sorted list for closest track
-  for (int n = 0; n < requestSize; n++)
-    {
-      trackDistance = abs(currentTrack - request[n].track);
-
-      if (trackDistance < currentClosest && request[n].accessed == false && request[n].track >= 2499) // if current location is closest, has not been accessed, and is greater than or equal to closest track save as closest
+      else if (strcmp(argv[arg], "--lbas-per-sector") == 0 && hasValue)
 	{
-	  currentClosest = trackDistance; // update closest track
-	  closestTrack = n; // save index of closest track
+	  opts.lbasPerSector = max(1ULL, strtoull(argv[++arg], NULL, 0));
 	}
-    } // end of linear search
-
-  int firstClosest = closestTrack; // store first closest to properly simulate scan
-
-  // for loop to iterate through request from closest index and then upwards and simulate scan
-  for (int i = closestTrack; i < requestSize; i++)
-    {
-      // track distance will be used to determine new current sector
-      trackDistance = abs(currentTrack - request[i].track);
-      currentTrack = request[i].track; // set current track as the requested track
-
-      // determine if snapback feature should be used
-      if ((trackDistance*.0008) < (1.5 + (currentTrack * .0008))) // if snapback is not faster (slower)
+      else if (strcmp(argv[arg], "--simulate") == 0 && hasValue)
 	{
-	  totalTime += (trackDistance * .0008); // add 800 nanoseconds for every track crossed
+	  opts.simulate = max(1L, atol(argv[++arg]));
 	}
-      else // if snapback is faster
+      else if (strcmp(argv[arg], "--arrival") == 0 && hasValue)
 	{
-	  totalTime += (1.5 + (currentTrack * .0008));
+	  arg++;
+	  if (strcmp(argv[arg], "poisson") == 0)
+	    opts.arrival = ARRIVAL_POISSON;
+	  else if (strcmp(argv[arg], "onoff") == 0)
+	    opts.arrival = ARRIVAL_ONOFF;
+	  else if (strcmp(argv[arg], "trace") == 0)
+	    opts.arrival = ARRIVAL_TRACE;
+	  else
+	    known = false;
 	}
-
-      // hdd is spinning counter clockwise
-      currentSector += ((trackDistance * .0008) / .0005); // calculate current sector as 1 sector is passed every 500 nanoseconds
-      currentSector = checkSector(currentSector); // call to function that makes sure sector is in range
-
-      if (currentSector > request[i].sector) // if requested sector is before current sector and requires another rotation
+      else if (strcmp(argv[arg], "--rate") == 0 && hasValue)
 	{
-	  totalTime += abs(((12000 - (currentSector - request[i].sector)) * .0005)); // add 500 nanoseconds for every sector crossed
+	  opts.rate = atof(argv[++arg]);
+	  known = (opts.rate > 0);
 	}
-      else // if requested sector is further on the track or in the correct spot
+      else if (strcmp(argv[arg], "--on-off") == 0 && arg + 2 < argc)
 	{
-	  totalTime += abs(((currentSector - request[i].sector) * .0005)); // add 500 nanoseconds for every sector crossed
+	  opts.onMs = atof(argv[++arg]);
+	  opts.offMs = atof(argv[++arg]);
+	  known = (opts.onMs > 0 && opts.offMs >= 0);
 	}
-
-      currentSector = request[i].sector; // set current sector to current request
-    } // end of first scan for loop
-
-  // for loop to iterate downwards through the request, simulating the head coming back on a scan
-  for (int i = firstClosest - 1; i >= 0; i--)
-    {
-      // track distance will be used to determine new current sector
-      trackDistance = abs(currentTrack - request[i].track);
-      currentTrack = request[i].track; // set current track as the requested track
-
-      // determine if snapback feature should be used
-      if ((trackDistance*.0008) < (1.5 + (currentTrack * .0008))) // if snapback is not faster (slower)
+      else if (strcmp(argv[arg], "--raid") == 0 && hasValue)
 	{
-	  totalTime += (trackDistance * .0008); // add 800 nanoseconds for every track crossed
+	  opts.raid = atoi(argv[++arg]);
+	  known = (opts.raid == 0 || opts.raid == 1 || opts.raid == 5 || opts.raid == 10);
 	}
-      else // if snapback is faster
+      else if (strcmp(argv[arg], "--disks") == 0 && hasValue)
 	{
-	  totalTime += (1.5 + (currentTrack * .0008));
+	  opts.disks = max(1, atoi(argv[++arg]));
 	}
-
-      // hdd is spinning counter clockwise
-      currentSector += ((trackDistance * .0008) / .0005); // calculate current sector as 1 sector is passed every 500 nanoseconds
-      currentSector = checkSector(currentSector); // call to function that makes sure sector is in range
-
-      if (currentSector > request[i].sector) // if requested sector is before current sector and requires another rotation
+      else if (strcmp(argv[arg], "--stripe-unit") == 0 && hasValue)
 	{
-	  totalTime += abs(((12000 - (currentSector - request[i].sector)) * .0005)); // add 500 nanoseconds for every sector crossed
+	  opts.stripeUnit = max(1, atoi(argv[++arg]));
 	}
-      else // if requested sector is further on the track or in the correct spot
+      else if (strcmp(argv[arg], "--request-sectors") == 0 && hasValue)
 	{
-	  totalTime += abs(((currentSector - request[i].sector) * .0005)); // add 500 nanoseconds for every sector crossed
+	  opts.requestSectors = max(1, atoi(argv[++arg]));
 	}
-
-      currentSector = request[i].sector; // set current sector to current request
-    }
-  // return average seek time in milliseconds
-  return (totalTime / requestSize);
-}
-
-/***************************************************************************
- * double cscan(point[], int)
- * Author: Logan Wheat
- * Date: 19 November 2019
- * Description: simulates a circular scan disk scheduling algorithm.
- *Calculates the total time spent seeking and then returns
- *(total time / request size) to calculate average seek time between
- *requests in milliseconds.
- *
- * Parameters:
- * request I/P point[]  array of points that will be accessed in cscan algorithm
- * requestSize I/P int  size of array of points, that way function does not exceed bounds
- **************************************************************************/
-double cscan(point request[], int requestSize)
-{
-  double totalTime = 0; // initialize total time to 0 in milliseconds
-
-  double currentTrack = 2499; // start in the middle of the track
-  double currentSector = 0; // start at sector 0
-  double trackDistance; // declare track distance as a double
-  int closestTrack; // declare closest track as an int
-  double currentClosest; // declare current closest as a double
-
-  currentClosest = 5000; // define current closest as the furthest possible distance
-
-  // for loop to search through sorted list for closest track
-  for (int n = 0; n < requestSize; n++)
-    {
-      trackDistance = abs(currentTrack - request[n].track);
-
-      if (trackDistance < currentClosest && request[n].accessed == false && request[n].track >= 2499) // if current location is closest, has not been accessed, and is greater than or equal to closest track save as closest
+      else if (strcmp(argv[arg], "--write-fraction") == 0 && hasValue)
 	{
-	  currentClosest = trackDistance; // update closest track
-	  closestTrack = n; // save index of closest track
+	  opts.writeFraction = atof(argv[++arg]);
+	  known = (opts.writeFraction >= 0 && opts.writeFraction <= 1);
 	}
-    } // end of linear search
-
-  int firstClosest = closestTrack; // store the first track accessed for future use
-
-  // for loop to iterate through request from closest index and then upwards and simulate cscan
-  for (int i = closestTrack; i < requestSize; i++)
-    {
-      // track distance will be used to determine new current sector
-      trackDistance = abs(currentTrack - request[i].track);
-      currentTrack = request[i].track; // set current track as the requested track
-
-      // determine if snapback feature should be used
-      if ((trackDistance*.0008) < (1.5 + (currentTrack * .0008))) // if snapback is not faster (slower)
+      else if (strcmp(argv[arg], "--sort") == 0 && hasValue && findSorter(argv[arg + 1]) != NULL)
 	{
-	  totalTime += (trackDistance * .0008); // add 800 nanoseconds for every track crossed
+	  opts.sorter = findSorter(argv[++arg]);
 	}
-      else // if snapback is faster
+      else if (strcmp(argv[arg], "--schedulers") == 0 && hasValue)
 	{
-	  totalTime += (1.5 + (currentTrack * .0008));
+	  known = parseSchedulers(argv[++arg], opts.schedulers);
 	}
-
-      // hdd is spinning counter clockwise
-      currentSector += ((trackDistance * .0008) / .0005); // calculate current sector as 1 sector is passed every 500 nanoseconds
-      currentSector = checkSector(currentSector); // call to function that makes sure sector is in range
-
-      if (currentSector > request[i].sector) // if requested sector is before current sector and requires another rotation
+      else if (strcmp(argv[arg], "--nstep") == 0 && hasValue)
 	{
-	  totalTime += abs(((12000 - (currentSector - request[i].sector)) * .0005)); // add 500 nanoseconds for every sector crossed
+	  opts.nstep = max(1, atoi(argv[++arg]));
 	}
-      else // if requested sector is further on the track or in the correct spot
+      else if (strcmp(argv[arg], "--interleave") == 0 && hasValue)
 	{
-	  totalTime += abs(((currentSector - request[i].sector) * .0005)); // add 500 nanoseconds for every sector crossed
+	  opts.interleave = min(MAX_INTERLEAVE, max(1, atoi(argv[++arg])));
 	}
-
-      currentSector = request[i].sector; // set current sector to current request
-    } // end of first cscan for loop
-
-  // for loop to iterate upward on the request, simulating the cscan looping
-  for (int i = 0; i < firstClosest; i++)
-    {
-      // track distance will be used to determine new current sector
-      trackDistance = abs(currentTrack - request[i].track);
-      currentTrack = request[i].track; // set current track as the requested track
-
-      // determine if snapback feature should be used
-      if ((trackDistance*.0008) < (1.5 + (currentTrack * .0008))) // if snapback is not faster (slower)
+      else if (strcmp(argv[arg], "--ci-target") == 0 && hasValue)
 	{
-	  totalTime += (trackDistance * .0008); // add 800 nanoseconds for every track crossed
+	  opts.ciTarget = atof(argv[++arg]);
+	  known = (opts.ciTarget > 0);
 	}
-      else // if snapback is faster
+      else if (strcmp(argv[arg], "--min-experiments") == 0 && hasValue)
 	{
-	  totalTime += (1.5 + (currentTrack * .0008));
+	  opts.minExperiments = max(2, atoi(argv[++arg]));
 	}
-
-      // hdd is spinning counter clockwise
-      currentSector += ((trackDistance * .0008) / .0005); // calculate current sector as 1 sector is passed every 500 nanoseconds
-      currentSector = checkSector(currentSector); // call to function that makes sure sector is in range
-
-      if (currentSector > request[i].sector) // if requested sector is before current sector and requires another rotation
+      else if (strcmp(argv[arg], "--disk") == 0 && hasValue)
+	{
+	  opts.disk = argv[++arg];
+	}
+      else if (strcmp(argv[arg], "--analytic") == 0)
 	{
-	  totalTime += abs(((12000 - (currentSector - request[i].sector)) * .0005)); // add 500 nanoseconds for every sector crossed
+	  opts.analytic = true;
 	}
-      else // if requested sector is further on the track or in the correct spot
+      else if (strcmp(argv[arg], "--samples") == 0 && hasValue)
 	{
-	  totalTime += abs(((currentSector - request[i].sector) * .0005)); // add 500 nanoseconds for every sector crossed
+	  opts.samples = max(NUM_CONTROLS + 3, atoi(argv[++arg]));
+	}
+      else
+	{
+	  known = false;
 	}
 
-      currentSector = request[i].sector; // set current sector to current request
+      if (!known)
+	{
+	  cerr << "usage: " << argv[0] << " [--threads N] [--seed S] [--experiments N] [--sizes FIRST-LAST] [--scaling]\n"
+	       << "  [--quiet] [--no-percentiles] [--results FILE.csv|FILE.dscol] [--raw FILE.csv|FILE.dscol]\n"
+	       << "  [--read-results FILE.dscol]\n"
+	       << "  [--checkpoint FILE [--checkpoint-seconds S]] [--resume] [--shared FILE] [--status FILE]\n"
+	       << "  [--ci-target MS [--min-experiments N]] [--schedulers all|NAME,NAME...] [--nstep N]\n"
+	       << "  [--interleave 1-" << MAX_INTERLEAVE << "]\n"
+	       << "  [--generator rejection|floyd|workload] [--zipf S] [--zone FIRST-LAST:WEIGHT]... [--sequential P]\n"
+	       << "  [--duplicates reject|allow|shift] [--sort counting|bubble|std]\n"
+	       << "  [--bench-sstf] [--bench-sort] [--bench-kernel] [--bench-interleave] [--check-order] [--check-trace]\n"
+	       << "  [--trace FILE [--trace-format blkparse|msr|binary]\n"
+	       << "  [--trace-out FILE] [--window N] [--lbas-per-sector N]]\n"
+	       << "  [--simulate N [--arrival poisson|onoff|trace] [--rate R] [--on-off ON OFF]\n"
+	       << "  [--raid 0|1|5|10 [--disks N] [--stripe-unit SECTORS] [--request-sectors N]\n"
+	       << "  [--write-fraction F]]]\n"
+	       << "  [--analytic [--samples N]] [--disk classic|FILE]\n"
+	       << "  [--bench [--bench-filter TEXT] [--bench-min-ms MS] [--bench-baseline FILE]] [--profile]\n"
+	       << "  [--perf] [--json FILE]\n"
+	       << "schedulers:";
+	  for (int i = 0; i < NUM_SCHEDULERS; i++)
+	    {
+	      cerr << " " << SCHEDULERS[i].name;
+	    }
+	  cerr << " (default " << DEFAULT_SCHEDULERS << ")\n";
+	  return false;
+	}
     }
 
-  // return average seek time in milliseconds
-  return (totalTime / requestSize);
+  // the disk model is set up once here, before any thread can read it
+  if (!loadDiskModel(opts.disk != NULL ? opts.disk : "classic", activeDisk))
+    return false;
+
+  if (opts.lastSize > activeDisk.addresses)
+    {
+      cerr << "--sizes goes past the " << activeDisk.addresses << " sectors of the disk\n";
+      return false;
+    }
+
+  // the workload options pick the workload generator
+  if (workload && opts.generator == sampleRequest)
+    {
+      cerr << "--zipf, --zone, --sequential and --duplicates need --generator workload\n";
+      return false;
+    }
+  if (workload)
+    opts.generator = workloadRequest;
+  if (opts.generator == workloadRequest && !buildWorkload(activeWorkload))
+    return false;
+
+  if (opts.resume && opts.checkpoint == NULL)
+    opts.checkpoint = "diskscheduling.ckpt";
+  if (opts.checkpoint != NULL && (opts.ciTarget > 0 || opts.scaling))
+    {
+      cerr << "--checkpoint and --resume only work with the fixed sweep\n";
+      return false;
+    }
+  if (opts.shared != NULL && (opts.ciTarget > 0 || opts.scaling || opts.checkpoint != NULL))
+    {
+      cerr << "--shared only works with the fixed sweep, and keeps its own progress instead of --checkpoint\n";
+      return false;
+    }
+
+  if (opts.raid >= 0)
+    {
+      int least = (opts.raid == 5) ? 3 : (opts.raid == 0) ? 1 : 2;
+
+      if (opts.simulate == 0)
+	cerr << "--raid needs --simulate N\n";
+      else if (opts.disks < least || (opts.raid == 10 && opts.disks % 2 != 0))
+	cerr << "raid " << opts.raid << " needs " << (opts.raid == 10 ? "an even number of disks, at least " : "at least ")
+	     << least << " disks\n";
+      else if (opts.stripeUnit > activeDisk.addresses)
+	cerr << "stripe unit larger than the disk\n";
+      else
+	return true;
+      return false;
+    }
+  return true;
 }
 
 /***************************************************************************
- * int main()
+ * int main(int, char *[])
  * Author: Logan Wheat
  * Date: 19 November 2019
- * Description: driver function of program. Generates random input streams with no duplicates
- *   for each experiment, runs each of disk the scheduling algorithms per experiment
- *   properly storing the average seek times, and outputs the average seek times
- *   calculated over the 1000 experiments for sizes 500-1000 to both standard out
- *   and a .csv file to properly generate line graph for report.
+ * Description: driver function of program. Runs the experiments for sizes
+ *   500-1000 (or --sizes) on a pool of worker threads (see runSweep), and outputs the
+ *   average seek times calculated over the experiments to both standard out
+ *   and a .csv file to properly generate line graph for report. The .csv
+ *   also gets the percentiles of the service times of every size, and a
+ *   percentile table over all sizes is printed after the averages;
+ *   --no-percentiles leaves both out and skips recording the service times.
+ *   With --scaling the sweep is repeated at increasing thread counts and a
+ *   scaling report is printed first. With --ci-target the adaptive sweep
+ *   runs instead, and the .csv says how many experiments each cell took;
+ *   the 95% confidence interval of every average is in the .csv either way.
+ *   With --profile the time of every phase (generating, sorting, loading
+ *   and each scheduler) is printed last, and written as JSON with --json;
+ *   --bench runs the benchmark suite instead of a sweep.
+ *   With --checkpoint the fixed sweep saves its progress as it goes, and
+ *   --resume carries on from the last save (a --raw file then only has the
+ *   experiments run after it).
  *
  * Parameters:
- * main O/P int  Status code (not currently used)
+ * argc I/P int  number of command line arguments
+ * argv I/P char*[]  command line arguments (see parseOptions)
+ * main O/P int  Status code, 1 if the command line was not understood
  **************************************************************************/
-int main()
+int main(int argc, char *argv[])
 {
-  ofstream fout; // declare output file that will not be used until averages are calulated
+  resultsSink results; // results file that will not be used until averages are calulated
+  resultsSink raw; // per experiment results, with --raw
+  simulationOptions opts;
+
+  vector<double> seekTime; // summed average seek times [size][scheduler]
+  vector<latencyHistogram> histogram; // service times of every request [size][scheduler]
+  vector<runningStat> stats; // mean and variance of the average seek times [size][scheduler]
+  phaseProfile profile; // time of every phase of the sweep, with --profile
+  phaseProfile *profiling; // &profile with --profile, NULL otherwise
+  double seconds; // wall clock time of the sweep
 
-  // declare 2d array for seek time
-  double seekTime[501][4] = { { 0 } };
-  point request[1000];
-  point sortedRequest[1000];
+  if (!parseOptions(argc, argv, opts))
+    return 1;
 
-  // for loop for total simulations
-  for (int experiment = 0; experiment < 1000; experiment++) // run 1000 experiments
+  if (opts.perf)
     {
-      // for loop for each I/O request size
-      for (int size = 500; size <= 1000; size++)
+      // find out once whether this machine lets us count, so every thread does not have to say so
+      perfCounters probe;
+
+      if (openPerfCounters(probe))
+	closePerfCounters(probe);
+      else
 	{
-	  // empty request and sortedRequest before filling it
-	  for (int i = 0; i < 1000; i++)
-	    {
-	      request[i].track = 0;
-	      request[i].sector = 0;
+	  cerr << "hardware counters not available (" << strerror(errno) << "), timing only\n";
+	  opts.perf = false;
+	}
+    }
+  if (opts.bench)
+    {
+      return benchSuite(opts);
+    }
+  if (opts.readResults != NULL)
+    {
+      return readResults(opts.readResults);
+    }
+  if (opts.status != NULL)
+    {
+      return sharedStatus(opts.status);
+    }
 
-	      sortedRequest[i].track = 0;
-	      sortedRequest[i].sector = 0;
-	    }
+  if (opts.benchSstf)
+    {
+      benchSstf();
+      return 0;
+    }
+  if (opts.benchSort)
+    {
+      benchSort();
+      return 0;
+    }
+  if (opts.benchKernel)
+    {
+      benchKernel();
+      return 0;
+    }
+  if (opts.benchInterleave)
+    {
+      benchInterleave();
+      return 0;
+    }
+  if (opts.checkOrder)
+    {
+      return checkOrder(opts);
+    }
+  if (opts.checkTrace)
+    {
+      return checkTrace();
+    }
 
-	  // fill points with uniform random numbers for I/O requests
-	  for (int i = 0; i < size; i++)
-	    {
-	      bool isPresent = false; // declare boolean to false that determines if point is in queue
+  if (opts.simulate > 0)
+    {
+      return (opts.raid >= 0) ? runArray(opts) : runOnline(opts);
+    }
+  if (opts.trace != NULL)
+    {
+      return replayTrace(opts);
+    }
+  if (!sinkWritable(opts.results))
+    {
+      return 1;
+    }
+  if (opts.analytic)
+    {
+      return runAnalytic(opts);
+    }
 
-	      do
-		{
-		  isPresent = false; // reset isPresent to false 
+  profiling = opts.profile ? &profile : NULL;
+  raw.file = NULL;
+  if (opts.raw != NULL)
+    {
+      vector<string> names = { "experiment", "size" };
+      string types = "ii";
 
-		  // declare temporary pointer to determine if point is in request already
-		  point temp;
+      for (const schedulerInfo *scheduler : opts.schedulers)
+	{
+	  names.push_back(scheduler->label);
+	  types += 'd';
+	}
+      if (!openSink(raw, opts.raw, names, types))
+	return 1;
+    }
 
-		  // fill temporary point with uniform random numbers
-		  temp.track = uniform(0, 4999);
-		  temp.sector = uniform(0, 11999);
+  if (opts.ciTarget > 0)
+    {
+      seconds = runAdaptive(opts, seekTime, histogram, stats, profiling, raw.file != NULL ? &raw : NULL);
+    }
+  else if (opts.scaling)
+    {
+      seconds = scalingReport(opts, seekTime, histogram, stats, profiling, raw.file != NULL ? &raw : NULL);
+    }
+  else if (opts.shared != NULL)
+    {
+      bool finished; // this process completed the last tile
 
-		  // for loop to search for temp in request
-		  for (int search = 0; search <= i; search++)
-		    {
-		      // if statement to see if point is already in I/O request
-		      if (temp.sector == request[search].sector)
-			{
-			  if (temp.track == request[search].track)
-			    {
-			      isPresent = true;
-			    }
-			}
-		    }
+      if (!runShared(opts, seekTime, histogram, stats, profiling, raw.file != NULL ? &raw : NULL, seconds, finished))
+	return 1;
+      if (!finished)
+	{
+	  // another process writes the results
+	  if (!opts.quiet)
+	    cout << "No tiles left in " << opts.shared << ", the process that completes the last one writes the results.\n";
+	  if (raw.file != NULL && !closeSink(raw))
+	    return 1;
+	  if (profiling != NULL)
+	    outputProfile(cout, profile, seconds, opts.perf);
+	  return 0;
+	}
+    }
+  else
+    {
+      int firstBlock = 0; // experiment blocks done before a --resume
 
-		  // if point is not present, add to request
-		  if (isPresent == false)
-		    {
-		      temp.accessed = false;
-		      request[i] = temp;
-		      sortedRequest[i] = temp;
-		    }
+      if (opts.resume)
+	{
+	  if (!readCheckpoint(opts, firstBlock, seekTime, histogram, stats))
+	    return 1;
+	  cout << "Resuming after experiment " << min(firstBlock * BLOCK_EXPERIMENTS, opts.experiments) << " of "
+	       << opts.experiments << ".\n";
+	}
+      seconds = runSweep(opts, seekTime, histogram, stats, profiling, raw.file != NULL ? &raw : NULL, firstBlock);
+    }
 
-		} while (isPresent == true);
-	    } // end of generating I/O requests 
+  int count = opts.schedulers.size();
+  int numSizes = opts.lastSize - opts.firstSize + 1;
+  vector<string> names(1, "Size"); // columns of the results file
+  string types = "i";
+  char percentile[32];
 
-	  // call to function to get sorted request, as it is needed for sstf, scan, and cscan
-	  sortRequest(sortedRequest, size);
+  // header for output, one column per selected scheduler
+  cout << "Size:";
+  for (int alg = 0; alg < count; alg++)
+    {
+      cout << "\t" << opts.schedulers[alg]->label << (alg + 1 < count ? "\t" : "\n");
+      names.push_back(opts.schedulers[alg]->label);
+      types += 'd';
+    }
+  for (int alg = 0; alg < count && opts.percentiles; alg++)
+    {
+      for (int p = 0; p < NUM_PERCENTILES; p++)
+	{
+	  snprintf(percentile, sizeof(percentile), " p%g", PERCENTILES[p]);
+	  names.push_back(opts.schedulers[alg]->label + string(percentile));
+	  types += 'd';
+	}
+      names.push_back(opts.schedulers[alg]->label + string(" max"));
+      types += 'd';
+    }
+  for (int alg = 0; alg < count; alg++)
+    {
+      names.push_back(opts.schedulers[alg]->label + string(" ci"));
+      names.push_back(opts.schedulers[alg]->label + string(" n"));
+      types += "di";
+    }
+  if (!openSink(results, opts.results, names, types))
+    return 1;
 
-	  seekTime[size - 500][0] += fifo(request, size);
-	  seekTime[size - 500][1] += sstf(sortedRequest, size);
-	  seekTime[size - 500][2] += scan(sortedRequest, size);
-	  seekTime[size - 500][3] += cscan(sortedRequest, size);
-	} // end of single experiment for loop
+  // output averages to standard out and the results file, a row at a time
+  vector<double> row;
+  for (int i = 0; i < numSizes; i++)
+    {
+      row.clear();
+      row.push_back(i + opts.firstSize);
+      cout << i + opts.firstSize;
+      for (int alg = 0; alg < count; alg++)
+	{
+	  double average = seekTime[i * count + alg] / stats[i * count + alg].count;
 
-      cout << "Experiment " <<  experiment +1 << " complete.\n";
+	  cout << "\t" << average << (alg + 1 < count ? "\t" : "");
+	  row.push_back(average);
+	}
+      cout << "\n";
+      for (int alg = 0; alg < count && opts.percentiles; alg++)
+	{
+	  const latencyHistogram &h = histogram[i * count + alg];
 
-    } // end of total experiments for loop
+	  for (int p = 0; p < NUM_PERCENTILES; p++)
+	    {
+	      row.push_back(latencyPercentile(h, PERCENTILES[p]));
+	    }
+	  row.push_back(h.max);
+	}
+      for (int alg = 0; alg < count; alg++)
+	{
+	  row.push_back(statHalfWidth(stats[i * count + alg]));
+	  row.push_back(stats[i * count + alg].count);
+	}
+      sinkRows(results, row.data(), 1);
+    } // end of output for loop
 
-  fout.open("diskscheduling.csv", ios::out); // open csv file to output averages
+  if (opts.percentiles)
+    {
+      cout << "Service times in milliseconds, all sizes\n";
+      outputPercentiles(cout, histogram.data(), numSizes, opts.schedulers);
+    }
 
-  // header for output
-  cout << "Size:\tFIFO\t\tSSTF\t\tSCAN\t\tC-SCAN\n";
-  fout << "Size, FIFO, SSTF, SCAN, C-SCAN\n"; // output to csv file
+  bool written = closeSink(results); // close output file
+  if (raw.file != NULL)
+    written &= closeSink(raw);
+  if (!written)
+    return 1;
 
-  // for loop to output averages to standard out and csv file
-  for (int i = 0; i <= 500; i++)
+  if (profiling != NULL)
     {
-      cout << i + 500 << "\t" << (seekTime[i][0] / 1000) << "\t\t" << (seekTime[i][1] / 1000) << "\t\t" << (seekTime[i][2] / 1000) << "\t\t" << (seekTime[i][3] / 1000) << endl;
-      fout << i + 500 << ", " << (seekTime[i][0] / 1000) << ", " << (seekTime[i][1] / 1000) << ", " << (seekTime[i][2] / 1000) << ", " << (seekTime[i][3] / 1000) << endl;
-    } // end of output for loop
-
-  fout.close(); // close output file
+      outputProfile(cout, profile, seconds, opts.perf);
+      if (opts.json != NULL && !writeProfileJson(opts.json, opts, profile, seconds))
+	return 1;
+    }
   return 0;
 }
-